@@ -11,6 +11,7 @@
 /* Includes */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "bme280_support.h"
 #include "bmi160_support.h"
 #include "opt3001.h"
@@ -23,11 +24,63 @@
 
 
 
+/********************************** Defines **************************************/
+
+/* Peripherals of the board, BSP_InitThread brings them up in this order */
+typedef enum
+{
+	BSP_JOYSTICK,
+	BSP_BACKCHANNEL,
+	BSP_RGBLEDS,
+	BSP_I2C,
+	BSP_OPT3001,
+	BSP_TMP007,
+	BSP_BMI160,
+	BSP_BME280,
+	BSP_NUM_PERIPHERALS
+} BSP_Peripheral_t;
+
+#define BSP_PERIPHERAL_BIT(peripheral) (1 << (peripheral))
+
+/* Initialized by BSP_InitBoard, the game needs them for the first frame */
+#define BSP_EAGER_PERIPHERALS (BSP_PERIPHERAL_BIT(BSP_JOYSTICK) | BSP_PERIPHERAL_BIT(BSP_BACKCHANNEL))
+
+/* Initialized by BSP_InitThread after launch, the rest wait for BSP_Require */
+#define BSP_BACKGROUND_PERIPHERALS (BSP_PERIPHERAL_BIT(BSP_RGBLEDS) | BSP_PERIPHERAL_BIT(BSP_OPT3001) | \
+                                    BSP_PERIPHERAL_BIT(BSP_TMP007) | BSP_PERIPHERAL_BIT(BSP_BMI160) | \
+                                    BSP_PERIPHERAL_BIT(BSP_BME280))
+
+/* Priority of BSP_InitThread, below the game threads */
+#define BSP_INIT_THREAD_PRIORITY 200
+
+/********************************** Defines **************************************/
+
+
+
 /********************************** Public Functions **************************************/
 
-/* Initializes the entire board */
+/* Initializes the clock and BSP_EAGER_PERIPHERALS */
 extern void BSP_InitBoard();
 
+/*
+ * Initializes a peripheral, and the ones it depends on, unless it already is
+ * Call before the first use of a peripheral that is not eager
+ * Blocks while another thread initializes a peripheral
+ */
+extern void BSP_Require(BSP_Peripheral_t peripheral);
+
+/* True once the peripheral is initialized */
+extern bool BSP_IsReady(BSP_Peripheral_t peripheral);
+
+/*
+ * Thread that initializes BSP_BACKGROUND_PERIPHERALS, then kills itself
+ * Their power up delays sleep, so the game runs meanwhile
+ */
+extern void BSP_InitThread();
+
+/* Waits ms, sleeping once the scheduler runs and busy waiting before */
+extern void BSP_DelayMs(uint32_t ms);
+
 /********************************** Public Functions **************************************/
 
 #endif /* BSP_H_ */
@@ -31,6 +31,12 @@ extern void BackChannelInit();
  */
 extern void BackChannelPrint(const char * string, BackChannelTextStyle_t textStyle);
 
+/*
+ * Writes string to the back channel UART as is, without the JSON wrapper
+ * Param 'string': String to be written, including any line ending
+ */
+extern void BackChannelWrite(const char * string);
+
 /*
  * Prints the value of an integer to the back channel UART
  * Param 'name': Name of the integer variable
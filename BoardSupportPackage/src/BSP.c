@@ -8,9 +8,118 @@
 #include <driverlib.h>
 #include "BSP.h"
 #include "i2c_driver.h"
+#include "demo_sysctl.h"
+#include "G8RTOS.h"
+#include "G8RTOS_Boot.h"
 
 
-/* Initializes the entire board */
+/********************************** Defines **************************************/
+
+/* Peripheral without a dependency */
+#define BSP_NONE -1
+
+/* How to bring up one peripheral */
+typedef struct
+{
+	const char * name;
+	void (*init)(void);
+	int8_t dependency;
+} BSP_PeripheralInfo_t;
+
+/********************************** Defines **************************************/
+
+
+
+/********************************** Private Functions **************************************/
+
+static void Opt3001Init()
+{
+	sensorOpt3001Enable(true);
+}
+
+static void Tmp007Init()
+{
+	sensorTmp007Enable(true);
+}
+
+static void Bmi160Init()
+{
+	bmi160_initialize_sensor();
+}
+
+static void Bme280Init()
+{
+	bme280_initialize_sensor();
+}
+
+/********************************** Private Functions **************************************/
+
+
+
+/********************************** Private Variables **************************************/
+
+static const BSP_PeripheralInfo_t Peripherals[BSP_NUM_PERIPHERALS] =
+{
+	[BSP_JOYSTICK]    = { "Joystick",        Joystick_Init_Without_Interrupt, BSP_NONE },
+	[BSP_BACKCHANNEL] = { "BackChannelInit", BackChannelInit,                 BSP_NONE },
+	[BSP_RGBLEDS]     = { "RGBLEDs",         init_RGBLEDS,                    BSP_NONE },
+	[BSP_I2C]         = { "initI2C",         initI2C,                         BSP_NONE },
+	[BSP_OPT3001]     = { "Opt3001",         Opt3001Init,                     BSP_I2C },
+	[BSP_TMP007]      = { "Tmp007",          Tmp007Init,                      BSP_I2C },
+	[BSP_BMI160]      = { "Bmi160",          Bmi160Init,                      BSP_I2C },
+	[BSP_BME280]      = { "Bme280",          Bme280Init,                      BSP_I2C },
+};
+
+static volatile bool Ready[BSP_NUM_PERIPHERALS];
+
+/* Held while a peripheral is initialized, so the sensor I2C bus has one user */
+static semaphore_t PeripheralMutex;
+
+/********************************** Private Variables **************************************/
+
+
+
+/********************************** Private Functions **************************************/
+
+/* Initializes peripheral and its dependency, PeripheralMutex must be held */
+static void InitPeripheral(BSP_Peripheral_t peripheral)
+{
+	const BSP_PeripheralInfo_t * info = &Peripherals[peripheral];
+
+	if (Ready[peripheral])
+	{
+		return;
+	}
+
+	if (info->dependency != BSP_NONE)
+	{
+		InitPeripheral((BSP_Peripheral_t)info->dependency);
+	}
+
+	/* Background inits interleave with the game threads, the boot profile only follows startup */
+	bool profiled = !G8RTOS_IsRunning();
+	if (profiled)
+	{
+		G8RTOS_BootBegin(info->name);
+	}
+
+	info->init();
+
+	if (profiled)
+	{
+		G8RTOS_BootEnd();
+	}
+
+	Ready[peripheral] = true;
+}
+
+/********************************** Private Functions **************************************/
+
+
+
+/********************************** Public Functions **************************************/
+
+/* Initializes the clock and BSP_EAGER_PERIPHERALS */
 void BSP_InitBoard()
 {
 	/* Disable Watchdog */
@@ -18,31 +127,79 @@ void BSP_InitBoard()
 	WDT_A_holdTimer();
 
 	/* Initialize Clock */
+	G8RTOS_BootBegin("ClockSys_SetMaxFreq");
 	ClockSys_SetMaxFreq();
+	G8RTOS_BootSetClock(ClockSys_GetSysFreq());
+	G8RTOS_BootEnd();
 
-	/* Init i2c */
-	initI2C();
-
-	/* Init Opt3001 */
-	sensorOpt3001Enable(true);
+	G8RTOS_InitSemaphore(&PeripheralMutex, 1);
 
-	/* Init Tmp007 */
-	sensorTmp007Enable(true);
+	/* Init what the first frame needs, the rest comes up on first use or in BSP_InitThread */
+	for (int peripheral = 0; peripheral < BSP_NUM_PERIPHERALS; peripheral++)
+	{
+		if (BSP_EAGER_PERIPHERALS & BSP_PERIPHERAL_BIT(peripheral))
+		{
+			BSP_Require((BSP_Peripheral_t)peripheral);
+		}
+	}
+}
 
-	/* Init Bmi160 */
-    bmi160_initialize_sensor();
+/*
+ * Initializes a peripheral, and the ones it depends on, unless it already is
+ * Call before the first use of a peripheral that is not eager
+ * Blocks while another thread initializes a peripheral
+ */
+void BSP_Require(BSP_Peripheral_t peripheral)
+{
+	if (Ready[peripheral])
+	{
+		return;
+	}
 
-    /* Init joystick without interrupts */
-	Joystick_Init_Without_Interrupt();
+	G8RTOS_WaitSemaphore(&PeripheralMutex);
+	InitPeripheral(peripheral);
+	G8RTOS_SignalSemaphore(&PeripheralMutex);
+}
 
-	/* Init Bme280 */
-	bme280_initialize_sensor();
+/* True once the peripheral is initialized */
+bool BSP_IsReady(BSP_Peripheral_t peripheral)
+{
+	return Ready[peripheral];
+}
 
-	/* Init BackChannel UART */
-	BackChannelInit();
+/*
+ * Thread that initializes BSP_BACKGROUND_PERIPHERALS, then kills itself
+ * Their power up delays sleep, so the game runs meanwhile
+ */
+void BSP_InitThread()
+{
+	for (int peripheral = 0; peripheral < BSP_NUM_PERIPHERALS; peripheral++)
+	{
+		if (BSP_BACKGROUND_PERIPHERALS & BSP_PERIPHERAL_BIT(peripheral))
+		{
+			BSP_Require((BSP_Peripheral_t)peripheral);
+		}
+	}
 
-	/* Init RGB LEDs */
-	init_RGBLEDS();
+	G8RTOS_KillSelf();
 }
 
+/* Waits ms, sleeping once the scheduler runs and busy waiting before */
+void BSP_DelayMs(uint32_t ms)
+{
+	if (ms == 0)
+	{
+		return;
+	}
+
+	if (G8RTOS_IsRunning())
+	{
+		G8RTOS_Sleep(ms);
+	}
+	else
+	{
+		DelayMs(ms);
+	}
+}
 
+/********************************** Public Functions **************************************/
@@ -109,6 +109,19 @@ void BackChannelPrint(const char * string, BackChannelTextStyle_t textStyle)
 	BackChannelTransmitString(backChannelStringBuff);
 }
 
+/*
+ * Writes string to the back channel UART as is, without the JSON wrapper
+ * Param 'string': String to be written, including any line ending
+ */
+void BackChannelWrite(const char * string)
+{
+	/* Loop while not null */
+	while(*string)
+	{
+		MAP_UART_transmitData(EUSCI_A0_BASE, *string++);
+	}
+}
+
 /*
  * Prints the value of an integer to the back channel UART
  * Param 'name': Name of the integer variable
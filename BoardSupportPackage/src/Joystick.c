@@ -9,22 +9,22 @@
 #include "msp.h"
 #include "Joystick.h"
 #include "driverlib.h"
+#include "G8RTOS.h"
+
+#if !G8RTOS_USE_GPIO
+#error "pin interrupts go through G8RTOS_AddGPIOEvent, set G8RTOS_USE_GPIO"
+#endif
 /*********************************************** Dependencies and Externs *************************************************************/
 
 
 /*********************************************** Defines *********************************************************************/
 #define X_COORD_ADC_PIN 0
 #define Y_COORD_ADC_PIN 1
-/*********************************************** Defines *********************************************************************/
-
-
 
-/*********************************************** Public Variables ********************************************************************/
-
-/* Function Pointer for calling user defined function for joystick button press */
-void (*ButtonFunction)(void);
+/* Button presses within this many ms of the last one are bounces */
+#define BUTTON_DEBOUNCE_MS 20
+/*********************************************** Defines *********************************************************************/
 
-/*********************************************** Public Variables ********************************************************************/
 
 
 /*********************************************** Public Functions *********************************************************************/
@@ -67,16 +67,11 @@ void Joystick_Push_Button_Init_With_Interrupt(void (*UserButtonFunction)(void))
 {
     /* Initialize Button Press Interrupt */
     // Configure Port4.3 to be used as GPIO interrupt for joystick button press -- falling edge triggered
-    P4->DIR &= ~BIT3;        // Set P4.3 as input
-    P4->IFG &= ~BIT3;       // P4.3 IFG cleared
-    P4->IE |= BIT3;         // Enable interrupt on P4.3
-    P4->IES |= BIT3;        // high-to-low transition
     P4->REN |= BIT3;        // Pull-up resister
     P4->OUT |= BIT3;
 
-    NVIC_EnableIRQ(PORT4_IRQn);
-    MAP_Interrupt_setPriority(INT_PORT4, 6);
-    ButtonFunction = UserButtonFunction;
+    // P4.3 shares the port 4 interrupt with the touch panel, the G8RTOS GPIO service dispatches it
+    G8RTOS_AddGPIOEvent(4, 3, GPIO_EDGE_FALLING, BUTTON_DEBOUNCE_MS, UserButtonFunction);
 }
 
 /*
@@ -84,8 +79,7 @@ void Joystick_Push_Button_Init_With_Interrupt(void (*UserButtonFunction)(void))
  */
 void Disable_Joystick_Interrupt()
 {
-    P4->IFG &= ~BIT3;       // P4.3 IFG cleared
-    P4->IE &= ~BIT3;         // Disable interrupt on P4.3
+    G8RTOS_RemoveGPIOEvent(4, 3);
 }
 
 /*
@@ -104,12 +98,5 @@ void GetJoystickCoordinates(int16_t *x_coord, int16_t *y_coord)
     *y_coord = ADC14->MEM[Y_COORD_ADC_PIN] - 0x1FFF;
 }
 
-//__interrupt void PORT4_IRQHandler (void)
-//{
-//    ButtonFunction();
-//
-//    P4->IFG &= ~BIT3;       // P4.3 IFG cleared
-//}
-
 /*********************************************** Public Functions *********************************************************************/
 
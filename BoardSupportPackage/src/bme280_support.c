@@ -57,6 +57,7 @@
 #include "i2c_driver.h"
 #include "bme280_support.h"
 #include "demo_sysctl.h"
+#include "BSP.h"
 
 #define BME280_API
 
@@ -526,6 +527,7 @@ s8 BME280_SPI_bus_write(u8 dev_addr, u8 reg_addr, u8 *reg_data, u8 cnt)
 void BME280_delay_msek(u16 msek)
 {
 	/*Here you can write your own delay routine*/
-	DelayMs(msek);
+	/* sleeps when initialized by BSP_InitThread */
+	BSP_DelayMs(msek);
 }
 #endif
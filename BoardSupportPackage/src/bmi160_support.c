@@ -54,6 +54,7 @@
 #include "driverlib.h"
 #include "i2c_driver.h"
 #include "demo_sysctl.h"
+#include "BSP.h"
 /* Mapping the structure*/
 struct bmi160_t s_bmi160;
 /* Read the sensor data of accel, gyro and mag*/
@@ -792,6 +793,6 @@ s8 bmi160_spi_bus_write(u8 dev_addr, u8 reg_addr, u8 *reg_data, u8 cnt)
  */
 void bmi160_delay_ms(u32 msek)
 {
-	/* user delay*/
-	DelayMs(msek);
+	/* user delay, sleeps when initialized by BSP_InitThread */
+	BSP_DelayMs(msek);
 }
@@ -36,6 +36,7 @@
 #include "msp432.h"
 #include "i2c_driver.h"
 #include "driverlib.h"
+#include "G8RTOS_Metrics.h"
 
 //*****************************************************************************
 //
@@ -50,6 +51,10 @@
 //*****************************************************************************
 volatile eUSCI_status ui8Status;
 
+/* transfers started and transfers a slave NACKed */
+G8RTOS_COUNTER(I2CTransfers, "i2c.transfers");
+G8RTOS_COUNTER(I2CNacks, "i2c.nack");
+
 uint8_t  *pData;
 uint8_t  ui8DummyRead;
 uint32_t g_ui32ByteCount;
@@ -108,6 +113,9 @@ void initI2C(void)
     /* Set interrupt to highest priority */
     NVIC_SetPriority(EUSCIB1_IRQn, 0);
 
+    G8RTOS_RegisterMetric(&I2CTransfers);
+    G8RTOS_RegisterMetric(&I2CNacks);
+
     /* Initializing I2C Master to SMCLK at 400kbs with autostop */
 //    MAP_I2C_initMaster(EUSCI_B1_BASE, &i2cConfig);
 }
@@ -142,6 +150,7 @@ bool writeI2C(uint8_t ui8Addr, uint8_t ui8Reg, uint8_t *Data, uint8_t ui8ByteCou
 
     /* Set our local state to Busy */
     ui8Status = eUSCI_BUSY;
+    G8RTOS_MetricAdd(&I2CTransfers, 1);
 
 	/* Send start bit and register */
   	MAP_I2C_masterSendMultiByteStart(EUSCI_B1_BASE,ui8Reg);
@@ -206,6 +215,7 @@ bool readI2C(uint8_t ui8Addr, uint8_t ui8Reg, uint8_t *Data, uint8_t ui8ByteCoun
 
     /* Set our local state to Busy */
     ui8Status = eUSCI_BUSY;
+    G8RTOS_MetricAdd(&I2CTransfers, 1);
 
   	/* Send start bit and register */
   	MAP_I2C_masterSendMultiByteStart(EUSCI_B1_BASE,ui8Reg);
@@ -293,6 +303,7 @@ bool readBurstI2C(uint8_t ui8Addr, uint8_t ui8Reg, uint8_t *Data, uint32_t ui32B
 
     /* Set our local state to Busy */
     ui8Status = eUSCI_BUSY;
+    G8RTOS_MetricAdd(&I2CTransfers, 1);
 
   	/* Send start bit and register */
   	MAP_I2C_masterSendMultiByteStart(EUSCI_B1_BASE,ui8Reg);
@@ -367,6 +378,7 @@ void EUSCIB1_IRQHandler(void)
 
         /* Set our local state to NACK received */
         ui8Status = eUSCI_NACK;
+        G8RTOS_MetricAdd(&I2CNacks, 1);
     }
 
     if (status & EUSCI_B_I2C_START_INTERRUPT)
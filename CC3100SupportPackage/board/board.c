@@ -37,6 +37,11 @@
 #include "simplelink.h"
 #include "board.h"
 #include "driverlib.h"
+#include "G8RTOS.h"
+
+#if !G8RTOS_USE_GPIO
+#error "pin interrupts go through G8RTOS_AddGPIOEvent, set G8RTOS_USE_GPIO"
+#endif
 
 #define XT1_XT2_PORT_SEL0            PJSEL0
 #define XT1_XT2_PORT_SEL1            PJSEL1
@@ -46,6 +51,8 @@
 
 P_EVENT_HANDLER                pIraEventHandler = 0;
 
+static void CC3100_IRQHandler(void);
+
 unsigned char IntIsMasked;
 
 
@@ -85,11 +92,8 @@ void CC3100_enable()
 
 void CC3100_InterruptEnable(void)
 {
-	// MSP432P401R = P2.5
-    P2IES &= ~BIT5;
-    P2IE |= BIT5;
-    MAP_Interrupt_enableInterrupt(INT_PORT2);
-    MAP_Interrupt_setPriority(INT_PORT2, 6);
+	// MSP432P401R = P2.5, dispatched by the G8RTOS GPIO service
+    G8RTOS_AddGPIOEvent(2, 5, GPIO_EDGE_RISING, 0, CC3100_IRQHandler);
     MAP_Interrupt_enableMaster();
 
 #ifdef SL_IF_TYPE_UART
@@ -101,10 +105,7 @@ void CC3100_InterruptEnable(void)
 void CC3100_InterruptDisable()
 {
 	// MMSP432P401R = P2.5
-    P2IE &= ~BIT5;
-    P2IFG &= ~BIT5;
-
-    MAP_Interrupt_disableInterrupt(INT_PORT2);
+    G8RTOS_RemoveGPIOEvent(2, 5);
 #ifdef SL_IF_TYPE_UART
     UCA0IE &= ~UCRXIE;
 #endif
@@ -330,31 +331,25 @@ void Delay(unsigned long interval)
 
     \return         none
 
-    \note
+    \note           Called by the G8RTOS GPIO service for P2.5, which
+                    clears the flag
 
     \warning
 */
-//#pragma vector=PORT2_VECTOR
-//__interrupt
-void PORT2_IRQHandler(void)
+static void CC3100_IRQHandler(void)
 {
-    if (P2IFG & BIT5)
-    {
-
 #ifndef SL_IF_TYPE_UART
-        if (pIraEventHandler)
-        {
-            pIraEventHandler(0);
-        }
+    if (pIraEventHandler)
+    {
+        pIraEventHandler(0);
+    }
 #else
-        if(puartFlowctrl->bRtsSetByFlowControl == FALSE)
-        {
-            clear_rts();
-        }
+    if(puartFlowctrl->bRtsSetByFlowControl == FALSE)
+    {
+        clear_rts();
+    }
 
 #endif
-        P2IFG &= ~ BIT5;
-    }
 }
 
 /*!
@@ -1,4 +1,6 @@
 #include "cc3100_usage.h"
+#include "G8RTOS_Boot.h"
+#include "G8RTOS_Metrics.h"
 
 
 /****** GLOBAL VARIABLES ******/
@@ -9,6 +11,15 @@ uint32_t receivedAlready = 0;
 uint32_t transmitedAlready = 0;
 _i16          SockIDRx = 0;
 _i16          SockIDTx = 0;
+
+/* game packets sent and received, and sends the CC3100 failed */
+G8RTOS_COUNTER(PacketsSent, "net.tx");
+G8RTOS_COUNTER(PacketsReceived, "net.rx");
+G8RTOS_COUNTER(SendErrors, "net.tx_errors");
+
+/* telemetry records sent to the collector, and sends the CC3100 failed */
+G8RTOS_COUNTER(TelemetrySent, "net.telemetry");
+G8RTOS_COUNTER(TelemetryErrors, "net.telemetry_errors");
 /****** GLOBAL VARIABLES ******/
 
 
@@ -165,6 +176,8 @@ static inline _i32 BsdUdpClient(_u16 Port, _u8 *data, _u32 IP, _u16 BUF_SIZE)
         //            Status = sl_Close(SockIDTx);
         //            ASSERT_ON_ERROR(BSD_UDP_CLIENT_FAILED);
         //        }
+        if( Status <= 0 )
+            return BSD_UDP_CLIENT_FAILED;
 
         LoopCount++;
     }
@@ -353,12 +366,20 @@ void initCC3100(playerType playerRole)
 //    asm("   CPSIE   I ");
     _i32 retVal = -1;
     g_Status = 0;
+    G8RTOS_RegisterMetric(&PacketsSent);
+    G8RTOS_RegisterMetric(&PacketsReceived);
+    G8RTOS_RegisterMetric(&SendErrors);
+    G8RTOS_RegisterMetric(&TelemetrySent);
+    G8RTOS_RegisterMetric(&TelemetryErrors);
+
+    G8RTOS_BootBegin("sl_default_state");
     retVal = configureSimpleLinkToDefaultState();
     if(retVal < 0)
     {
         /* Failed to configure the device in its default state */
         LOOP_FOREVER();
     }
+    G8RTOS_BootEnd();
 
     /* Device is configured in default state */
 
@@ -367,6 +388,7 @@ void initCC3100(playerType playerRole)
      * and it is in its default state
      */
     /* Initializing the CC3100 device */
+    G8RTOS_BootBegin("sl_Start");
     retVal = sl_Start(0, 0, 0);
     if ((retVal < 0) ||
             (ROLE_STA != retVal) )
@@ -374,9 +396,11 @@ void initCC3100(playerType playerRole)
         /* Failed to start device */
         LOOP_FOREVER();
     }
+    G8RTOS_BootEnd();
 
     /* Device started as STATION */
 
+    G8RTOS_BootBegin("sl_ip_config");
     if(playerRole == Client)
     {
         /* Configuring device in DHCP mode */
@@ -418,15 +442,18 @@ void initCC3100(playerType playerRole)
         if(retVal < 0)
             LOOP_FOREVER();
     }
+    G8RTOS_BootEnd();
 
     /* Connecting to WLAN AP - Set with static parameters defined at the top
        After this call we will be connected and have IP address */
+    G8RTOS_BootBegin("connect_AP");
     retVal = establishConnectionWithAP();
     if(retVal < 0)
     {
         /* Failed to establish connection w/ an AP */
         LOOP_FOREVER();
     }
+    G8RTOS_BootEnd();
 
     /* Connection established w/ AP and IP is acquired */
 
@@ -442,10 +469,27 @@ void SendData(_u8 *data, _u32 IP, _u16 BUF_SIZE)
     /* Sending data to UDP server */
     retVal = BsdUdpClient(PORT_NUM, data, IP, BUF_SIZE);
 
-    //    if(retVal < 0)
-    //        /* Failed to send data to UDP server */
-    //    else
-    //        /* Successfully sent data to UDP server */
+    if(retVal < 0)
+        /* Failed to send data to UDP server */
+        G8RTOS_MetricAdd(&SendErrors, 1);
+    else
+        /* Successfully sent data to UDP server */
+        G8RTOS_MetricAdd(&PacketsSent, 1);
+}
+
+/*
+ * Function sends a telemetry record to the collector on TELEMETRY_PORT_NUM
+ */
+_i32 SendTelemetry(_u8 *data, _u16 BUF_SIZE)
+{
+    _i32 status = BsdUdpClient(TELEMETRY_PORT_NUM, data, TELEMETRY_IP_ADDR, BUF_SIZE);
+
+    if(status < 0)
+        G8RTOS_MetricAdd(&TelemetryErrors, 1);
+    else
+        G8RTOS_MetricAdd(&TelemetrySent, 1);
+
+    return status;
 }
 
 /*
@@ -459,6 +503,8 @@ _i32 ReceiveData(_u8 *data, _u16 BUF_SIZE)
     //        /* Failed to read data from the UDP client */
     //    else
     //        /* Successfully received data from UDP client */
+    if(retVal == SUCCESS)
+        G8RTOS_MetricAdd(&PacketsReceived, 1);
     return retVal;
 }
 
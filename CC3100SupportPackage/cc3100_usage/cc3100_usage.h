@@ -93,6 +93,12 @@ typedef enum
 
 #endif
 
+/* Telemetry records go to a collector on TELEMETRY_PORT_NUM, apart from PORT_NUM so the
+ * other player never reads one as a game packet. Broadcast reaches a collector anywhere on the LAN
+ */
+#define TELEMETRY_IP_ADDR      0xFFFFFFFF
+#define TELEMETRY_PORT_NUM     5002
+
 /* Application specific status/error codes */
 typedef enum{
     DEVICE_NOT_IN_STATION_MODE = -0x7D0,        /* Choosing this number to avoid overlap w/ host-driver's error codes */
@@ -107,6 +113,7 @@ typedef enum{
 
 /*********************** User Functions ************************/
 void SendData(_u8 *data, _u32 IP, _u16 BUF_SIZE);
+_i32 SendTelemetry(_u8 *data, _u16 BUF_SIZE);
 _i32 ReceiveData(_u8 *data, _u16 BUF_SIZE);
 void initCC3100(playerType playerRole);
 _u32 getLocalIP();
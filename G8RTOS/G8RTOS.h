@@ -17,8 +17,22 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "G8RTOS_Config.h"
 #include "G8RTOS_Semaphores.h"
 #include "G8RTOS_Scheduler.h"
 #include "G8RTOS_IPC.h"
+#include "G8RTOS_Tasks.h"
+#include "G8RTOS_Pool.h"
+#include "G8RTOS_Heap.h"
+#include "G8RTOS_Mailbox.h"
+#include "G8RTOS_Ring.h"
+#include "G8RTOS_Topic.h"
+#include "G8RTOS_Stream.h"
+#include "G8RTOS_Seqlock.h"
+#include "G8RTOS_GPIO.h"
+#include "G8RTOS_Bench.h"
+#include "G8RTOS_Profiler.h"
+#include "G8RTOS_Boot.h"
+#include "G8RTOS_Metrics.h"
 
 #endif /* G8RTOS_H_ */
@@ -0,0 +1,433 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/19/2020                                                |
+ * | SUMMARY: G8RTOS_Bench.c                                         |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#include "G8RTOS_Config.h"
+
+#if G8RTOS_USE_BENCH
+
+#if !G8RTOS_USE_IPC
+#error "the benchmarks time FIFOs, they need G8RTOS_USE_IPC"
+#endif
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "msp.h"
+#include "BackChannelUart.h"
+#include "G8RTOS.h"
+#include "G8RTOS_Port.h"
+#include "G8RTOS_CriticalSection.h"
+
+/* kernel tick, timed directly in the systick scenario */
+extern void SysTick_Handler();
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                        DEFINES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* samples for scenarios that sleep, they take ms each */
+#define SLEEP_SAMPLES 100
+
+/* most threads parked by the systick scenario */
+#define MAX_PARKED 16
+
+/* length of one CSV line */
+#define LINE_LENGTH 96
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                  DATA TYPE DEFINITIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Benchmark Result
+ * Running min, max and total of the cycle samples taken
+ * for one scenario
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef struct benchResult {
+    uint32_t samples;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+} benchResult_t;
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PRIVATE VARIABLES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* ping pong semaphores */
+static semaphore_t PingSemaphore;
+static semaphore_t PongSemaphore;
+
+/* parked threads wait here until killed */
+static semaphore_t ParkSemaphore;
+
+/* ids of the parked threads */
+static threadID_t ParkedIDs[MAX_PARKED];
+static uint32_t NumberOfParked;
+
+/* cycles when the ping thread started blocking */
+static uint32_t SwitchStart;
+
+/* one way switch samples, taken by the pong thread */
+static benchResult_t SwitchResult;
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PRIVATE FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * ResetResult
+ * INPUTS: (benchResult_t *) result
+ * OUTPUTS: void
+ * Clears result before a scenario
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void ResetResult(benchResult_t *result)
+{
+    result->samples = 0;
+    result->min = UINT32_MAX;
+    result->max = 0;
+    result->total = 0;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * AddSample
+ * INPUTS: (benchResult_t *) result, (uint32_t) cycles
+ * OUTPUTS: void
+ * Adds one sample to result
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void AddSample(benchResult_t *result, uint32_t cycles)
+{
+    result->samples++;
+    result->total += cycles;
+    if (cycles < result->min) result->min = cycles;
+    if (cycles > result->max) result->max = cycles;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * PrintResult
+ * INPUTS: (const char *) scenario, (uint32_t) param,
+ *         (benchResult_t *) result
+ * OUTPUTS: void
+ * Writes result as one CSV line
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void PrintResult(const char *scenario, uint32_t param, benchResult_t *result)
+{
+    char line[LINE_LENGTH];
+    uint32_t mean = result->samples ? result->total / result->samples : 0;
+
+    snprintf(line, LINE_LENGTH, "%s,%lu,%lu,%lu,%lu,%lu\r\n", scenario,
+             (unsigned long)param, (unsigned long)result->samples,
+             (unsigned long)(result->samples ? result->min : 0),
+             (unsigned long)mean, (unsigned long)result->max);
+    BackChannelWrite(line);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * PongThread
+ * INPUTS: void
+ * OUTPUTS: void
+ * Answers every ping and times the switch from the
+ * ping thread blocking to this thread running
+ *  - The first round is a warm up and not recorded
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void PongThread()
+{
+    for (uint32_t i = 0; i <= BENCH_SAMPLES; i++) {
+        G8RTOS_WaitSemaphore(&PingSemaphore);
+        uint32_t cycles = G8RTOS_PortCycles() - SwitchStart;
+        if (i) AddSample(&SwitchResult, cycles);
+        G8RTOS_SignalSemaphore(&PongSemaphore);
+    }
+
+    G8RTOS_KillSelf();
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * ParkedThread
+ * INPUTS: void
+ * OUTPUTS: void
+ * Stores its id and blocks until it is killed
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void ParkedThread()
+{
+    ParkedIDs[NumberOfParked++] = G8RTOS_GetThreadId();
+    G8RTOS_WaitSemaphore(&ParkSemaphore);
+    while(1);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * BenchIdleThread
+ * INPUTS: void
+ * OUTPUTS: void
+ * Runs while every benchmark thread is blocked
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void BenchIdleThread()
+{
+    while(1);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * BenchPingPong
+ * INPUTS: void
+ * OUTPUTS: void
+ * Bounces a semaphore with PongThread at the same
+ * priority
+ *  - context_switch is one way, from blocking on the
+ *    semaphore until the other thread runs
+ *  - sem_pingpong is the whole round trip
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void BenchPingPong()
+{
+    benchResult_t result;
+
+    ResetResult(&result);
+    ResetResult(&SwitchResult);
+    G8RTOS_InitSemaphore(&PingSemaphore, 0);
+    G8RTOS_InitSemaphore(&PongSemaphore, 0);
+    G8RTOS_AddThread(PongThread, BENCH_PRIORITY, "BenchPong");
+
+    for (uint32_t i = 0; i <= BENCH_SAMPLES; i++) {
+        uint32_t start = G8RTOS_PortCycles();
+        G8RTOS_SignalSemaphore(&PingSemaphore);
+        SwitchStart = G8RTOS_PortCycles();
+        G8RTOS_WaitSemaphore(&PongSemaphore);
+        uint32_t cycles = G8RTOS_PortCycles() - start;
+        if (i) AddSample(&result, cycles);
+    }
+
+    PrintResult("context_switch", 0, &SwitchResult);
+    PrintResult("sem_pingpong", 0, &result);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * BenchFIFO
+ * INPUTS: void
+ * OUTPUTS: void
+ * Times FIFO 0 from a single thread
+ *  - fifo_roundtrip is one writeFIFO and readFIFO
+ *  - fifo_throughput fills and drains all FIFOSIZE
+ *    slots, reported per element
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void BenchFIFO()
+{
+    benchResult_t result;
+
+    G8RTOS_InitFIFO(0);
+
+    ResetResult(&result);
+    for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+        uint32_t start = G8RTOS_PortCycles();
+        writeFIFO(0, i);
+        readFIFO(0);
+        AddSample(&result, G8RTOS_PortCycles() - start);
+    }
+    PrintResult("fifo_roundtrip", 1, &result);
+
+    ResetResult(&result);
+    for (uint32_t i = 0; i < BENCH_SAMPLES / FIFOSIZE; i++) {
+        uint32_t start = G8RTOS_PortCycles();
+        for (uint32_t j = 0; j < FIFOSIZE; j++) writeFIFO(0, j);
+        for (uint32_t j = 0; j < FIFOSIZE; j++) readFIFO(0);
+        AddSample(&result, (G8RTOS_PortCycles() - start) / FIFOSIZE);
+    }
+    PrintResult("fifo_throughput", FIFOSIZE, &result);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * BenchSleep
+ * INPUTS: void
+ * OUTPUTS: void
+ * Times G8RTOS_Sleep for a few durations, param is the
+ * duration in ms
+ *  - Each sample starts right after a tick, so ideal is
+ *    param * cycles_per_ms
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void BenchSleep()
+{
+    static const uint32_t durations[] = { 1, 5, 10 };
+    benchResult_t result;
+
+    for (uint32_t d = 0; d < sizeof(durations) / sizeof(durations[0]); d++) {
+        ResetResult(&result);
+        for (uint32_t i = 0; i < SLEEP_SAMPLES; i++) {
+            /* align to a tick */
+            G8RTOS_Sleep(1);
+
+            uint32_t start = G8RTOS_PortCycles();
+            G8RTOS_Sleep(durations[d]);
+            AddSample(&result, G8RTOS_PortCycles() - start);
+        }
+        PrintResult("sleep_wake", durations[d], &result);
+    }
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * BenchAddKill
+ * INPUTS: void
+ * OUTPUTS: void
+ * Times G8RTOS_AddThread and G8RTOS_KillThread of a
+ * thread blocked on a semaphore
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void BenchAddKill()
+{
+    benchResult_t addResult;
+    benchResult_t killResult;
+
+    ResetResult(&addResult);
+    ResetResult(&killResult);
+
+    for (uint32_t i = 0; i < SLEEP_SAMPLES; i++) {
+        G8RTOS_InitSemaphore(&ParkSemaphore, 0);
+        NumberOfParked = 0;
+
+        uint32_t start = G8RTOS_PortCycles();
+        G8RTOS_AddThread(ParkedThread, BENCH_PRIORITY - 1, "BenchParked");
+        AddSample(&addResult, G8RTOS_PortCycles() - start);
+
+        /* let it run and block */
+        G8RTOS_Sleep(1);
+
+        start = G8RTOS_PortCycles();
+        G8RTOS_KillThread(ParkedIDs[0]);
+        AddSample(&killResult, G8RTOS_PortCycles() - start);
+    }
+
+    PrintResult("add_thread", 0, &addResult);
+    PrintResult("kill_thread", 0, &killResult);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * BenchSysTick
+ * INPUTS: void
+ * OUTPUTS: void
+ * Times SysTick_Handler against the number of threads,
+ * param is the number of threads alive
+ *  - The handler is called directly inside a critical
+ *    section, every call advances SystemTime by 1 ms
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void BenchSysTick()
+{
+    static const uint32_t parked[] = { 0, 4, 8, MAX_PARKED };
+    benchResult_t result;
+
+    for (uint32_t p = 0; p < sizeof(parked) / sizeof(parked[0]); p++) {
+        G8RTOS_InitSemaphore(&ParkSemaphore, 0);
+        NumberOfParked = 0;
+        for (uint32_t i = 0; i < parked[p]; i++) {
+            G8RTOS_AddThread(ParkedThread, BENCH_PRIORITY - 1, "BenchParked");
+        }
+
+        /* let them run and block */
+        G8RTOS_Sleep(1);
+
+        ResetResult(&result);
+        for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+            int32_t status = StartCriticalSection();
+            uint32_t start = G8RTOS_PortCycles();
+            SysTick_Handler();
+            uint32_t cycles = G8RTOS_PortCycles() - start;
+            EndCriticalSection(status);
+            AddSample(&result, cycles);
+        }
+
+        /* benchmark and idle thread are alive as well */
+        PrintResult("systick", NumberOfParked + 2, &result);
+
+        for (uint32_t i = 0; i < NumberOfParked; i++) {
+            G8RTOS_KillThread(ParkedIDs[i]);
+        }
+    }
+}
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_Benchmark
+ * INPUTS: void
+ * OUTPUTS: void
+ * Thread that measures the kernel with the port cycle
+ * counter and writes one CSV line per scenario to the
+ * back channel UART:
+ *   scenario,param,samples,min_cycles,mean_cycles,max_cycles
+ *  - Add it as the only thread at BENCH_PRIORITY, it
+ *    adds its own helpers and idle thread
+ *  - Prints "#done" when finished, the host build then
+ *    exits, the board kills the thread
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_Benchmark()
+{
+    char line[LINE_LENGTH];
+
+    G8RTOS_AddThread(BenchIdleThread, 254, "BenchIdle");
+    G8RTOS_PortInitCycles();
+
+    snprintf(line, LINE_LENGTH, "# G8RTOS benchmark, cycles_per_ms=%lu\r\n",
+             (unsigned long)G8RTOS_PortCyclesPerMS());
+    BackChannelWrite(line);
+    BackChannelWrite("scenario,param,samples,min_cycles,mean_cycles,max_cycles\r\n");
+
+    BenchPingPong();
+    BenchFIFO();
+    BenchSleep();
+    BenchAddKill();
+    BenchSysTick();
+
+    BackChannelWrite("#done\r\n");
+
+#ifdef G8RTOS_PORT_POSIX
+    exit(0);
+#else
+    G8RTOS_KillSelf();
+#endif
+}
+
+#endif /* G8RTOS_USE_BENCH */
@@ -0,0 +1,48 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/19/2020                                                |
+ * | SUMMARY: G8RTOS_Bench.h                                         |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifndef G8RTOS_BENCH_H_
+#define G8RTOS_BENCH_H_
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include "G8RTOS_Config.h"
+
+#if G8RTOS_USE_BENCH
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_Benchmark
+ * INPUTS: void
+ * OUTPUTS: void
+ * Thread that measures the kernel with the port cycle
+ * counter and writes one CSV line per scenario to the
+ * back channel UART:
+ *   scenario,param,samples,min_cycles,mean_cycles,max_cycles
+ *  - Add it as the only thread at BENCH_PRIORITY, it
+ *    adds its own helpers and idle thread
+ *  - Prints "#done" when finished, the host build then
+ *    exits, the board kills the thread
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_Benchmark();
+
+#endif /* G8RTOS_USE_BENCH */
+
+#endif /* G8RTOS_BENCH_H_ */
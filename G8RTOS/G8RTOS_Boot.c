@@ -0,0 +1,313 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/21/2020                                                |
+ * | SUMMARY: G8RTOS_Boot.c                                          |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#include "G8RTOS_Config.h"
+
+#if G8RTOS_USE_BOOT_PROFILE
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include "BackChannelUart.h"
+#include "G8RTOS_Boot.h"
+#include "G8RTOS_Port.h"
+#include "G8RTOS_Scheduler.h"
+#include "G8RTOS_CriticalSection.h"
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                        DEFINES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* marks a boot table that was started */
+#define BOOT_MAGIC 0xB007B007
+
+/* open phase that was not recorded */
+#define NOT_RECORDED 0xFFFFFFFF
+
+/* length of one CSV line */
+#define LINE_LENGTH 96
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                  DATA TYPE DEFINITIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Boot Entry
+ * One phase, times in us since G8RTOS_BootStart
+ *  - endUS is 0 while the phase is open
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef struct bootEntry {
+    const char *name;
+    uint32_t depth;
+    uint32_t startUS;
+    uint32_t endUS;
+} bootEntry_t;
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Boot Table
+ * The phases and the clock they are timed with
+ *  - open holds the entry of every open phase, the
+ *    innermost at depth - 1
+ *  - timeNS adds up the cycles seen at every mark so a
+ *    clock change only affects later cycles
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef struct bootTable {
+    uint32_t magic;
+    uint32_t numberOfEntries;
+    uint32_t depth;
+    uint32_t open[BOOT_DEPTH];
+    uint32_t cyclesPerMS;
+    uint32_t lastCycles;
+    uint32_t lastSystemTime;
+    uint64_t timeNS;
+    bootEntry_t entries[BOOT_ENTRIES];
+} bootTable_t;
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PRIVATE VARIABLES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* not cleared by C initialization, see msp432p401r.cmd */
+#ifdef __TI_COMPILER_VERSION__
+#pragma NOINIT(Boot)
+#endif
+static bootTable_t Boot;
+
+/* cleared by G8RTOS_BootStart, set again when C initialization copies .data */
+static uint32_t CInitDone = 1;
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                   PRIVATE FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * StartTable
+ * INPUTS: (uint32_t) cyclesPerMS
+ * OUTPUTS: void
+ * Clears the table and starts timing from now
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void StartTable(uint32_t cyclesPerMS)
+{
+    G8RTOS_PortInitCycles();
+
+    Boot.numberOfEntries = 0;
+    Boot.depth = 0;
+    Boot.cyclesPerMS = cyclesPerMS;
+    Boot.lastCycles = G8RTOS_PortCycles();
+    Boot.lastSystemTime = 0;
+    Boot.timeNS = 0;
+    Boot.magic = BOOT_MAGIC;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Now
+ * INPUTS: void
+ * OUTPUTS: (uint32_t) us
+ * Adds the cycles since the last mark to the boot time
+ * and returns it
+ *  - The counter wraps after 2^32 cycles (89 s at
+ *    48 MHz), a longer gap between marks, like waiting
+ *    for the other player, is taken from SystemTime
+ *  - SystemTime is only read after C initialization,
+ *    before it the variable holds whatever RAM held
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static uint32_t Now()
+{
+    uint32_t cycles = G8RTOS_PortCycles();
+    uint64_t deltaNS = (uint64_t)(cycles - Boot.lastCycles) * 1000000 / Boot.cyclesPerMS;
+    Boot.lastCycles = cycles;
+
+    if (CInitDone)
+    {
+        uint32_t deltaMS = SystemTime - Boot.lastSystemTime;
+        Boot.lastSystemTime = SystemTime;
+
+        /* more than half a wrap of ticks, the cycles cannot be trusted */
+        if (deltaMS > 0xFFFFFFFF / Boot.cyclesPerMS / 2)
+            deltaNS = (uint64_t)deltaMS * 1000000;
+    }
+
+    Boot.timeNS += deltaNS;
+    return (uint32_t)(Boot.timeNS / 1000);
+}
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_BootStart
+ * INPUTS: void
+ * OUTPUTS: void
+ * Starts the cycle counter and clears the boot table,
+ * time 0 of the profile
+ *  - First call in Reset_Handler, runs before C
+ *    initialization so it only touches the table
+ *  - Counts cycles at BOOT_RESET_CLOCK_HZ until
+ *    G8RTOS_BootSetClock
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_BootStart()
+{
+    CInitDone = 0;
+    StartTable(BOOT_RESET_CLOCK_HZ / 1000);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_BootBegin
+ * INPUTS: (const char *) name
+ * OUTPUTS: void
+ * Opens a phase inside the phase currently open
+ *  - name must outlive the boot, use a literal
+ *  - Starts the profile if G8RTOS_BootStart was not
+ *    called, as on the host
+ *  - Phases past BOOT_ENTRIES or BOOT_DEPTH are not
+ *    recorded but still have to be ended
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_BootBegin(const char *name)
+{
+    int32_t status = StartCriticalSection();
+
+    if (Boot.magic != BOOT_MAGIC)
+        StartTable(G8RTOS_PortCyclesPerMS());
+
+    uint32_t now = Now();
+    uint32_t entry = NOT_RECORDED;
+
+    if (Boot.depth < BOOT_DEPTH && Boot.numberOfEntries < BOOT_ENTRIES)
+    {
+        entry = Boot.numberOfEntries++;
+        Boot.entries[entry].name = name;
+        Boot.entries[entry].depth = Boot.depth;
+        Boot.entries[entry].startUS = now;
+        Boot.entries[entry].endUS = 0;
+    }
+
+    if (Boot.depth < BOOT_DEPTH)
+        Boot.open[Boot.depth] = entry;
+    Boot.depth++;
+
+    EndCriticalSection(status);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_BootEnd
+ * INPUTS: void
+ * OUTPUTS: void
+ * Closes the phase opened last
+ *  - Does nothing if no phase is open
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_BootEnd()
+{
+    int32_t status = StartCriticalSection();
+
+    if (Boot.magic == BOOT_MAGIC && Boot.depth > 0)
+    {
+        uint32_t now = Now();
+
+        Boot.depth--;
+        if (Boot.depth < BOOT_DEPTH && Boot.open[Boot.depth] != NOT_RECORDED)
+            Boot.entries[Boot.open[Boot.depth]].endUS = now;
+    }
+
+    EndCriticalSection(status);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_BootSetClock
+ * INPUTS: (uint32_t) hz
+ * OUTPUTS: void
+ * Tells the profile that MCLK now runs at hz, call it
+ * right after changing the clock
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_BootSetClock(uint32_t hz)
+{
+    int32_t status = StartCriticalSection();
+
+    if (Boot.magic == BOOT_MAGIC)
+    {
+        /* cycles so far ran at the old clock */
+        Now();
+        Boot.cyclesPerMS = hz / 1000;
+    }
+
+    EndCriticalSection(status);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_BootPrint
+ * INPUTS: void
+ * OUTPUTS: void
+ * Writes the boot table to the back channel UART, one
+ * CSV line per phase in the order they began:
+ *   phase,depth,start_us,duration_us
+ *  - Phases still open print their time so far
+ *  - Ends with "#boot_us=" and the time since reset
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_BootPrint()
+{
+    char line[LINE_LENGTH];
+
+    if (Boot.magic != BOOT_MAGIC)
+        return;
+
+    int32_t status = StartCriticalSection();
+    uint32_t now = Now();
+    EndCriticalSection(status);
+
+    BackChannelWrite("# G8RTOS boot profile\r\n");
+    BackChannelWrite("phase,depth,start_us,duration_us\r\n");
+
+    for (uint32_t i = 0; i < Boot.numberOfEntries; i++)
+    {
+        bootEntry_t *entry = &Boot.entries[i];
+        uint32_t end = entry->endUS ? entry->endUS : now;
+
+        snprintf(line, LINE_LENGTH, "%s,%lu,%lu,%lu\r\n", entry->name,
+                 (unsigned long)entry->depth, (unsigned long)entry->startUS,
+                 (unsigned long)(end - entry->startUS));
+        BackChannelWrite(line);
+    }
+
+    snprintf(line, LINE_LENGTH, "#boot_us=%lu\r\n", (unsigned long)now);
+    BackChannelWrite(line);
+}
+
+#endif /* G8RTOS_USE_BOOT_PROFILE */
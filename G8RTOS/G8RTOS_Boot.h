@@ -0,0 +1,114 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/21/2020                                                |
+ * | SUMMARY: G8RTOS_Boot.h                                          |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifndef G8RTOS_BOOT_H_
+#define G8RTOS_BOOT_H_
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include "G8RTOS_Config.h"
+
+/*
+ * The boot profile times the startup sequence from
+ * Reset_Handler to the first game frame. Phases nest,
+ * every G8RTOS_BootBegin is closed by a G8RTOS_BootEnd,
+ * and are kept in a RAM table that C initialization
+ * does not clear, so marks taken before _c_int00 and
+ * the table of the last boot survive
+ */
+
+#if G8RTOS_USE_BOOT_PROFILE
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_BootStart
+ * INPUTS: void
+ * OUTPUTS: void
+ * Starts the cycle counter and clears the boot table,
+ * time 0 of the profile
+ *  - First call in Reset_Handler, runs before C
+ *    initialization so it only touches the table
+ *  - Counts cycles at BOOT_RESET_CLOCK_HZ until
+ *    G8RTOS_BootSetClock
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_BootStart();
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_BootBegin
+ * INPUTS: (const char *) name
+ * OUTPUTS: void
+ * Opens a phase inside the phase currently open
+ *  - name must outlive the boot, use a literal
+ *  - Starts the profile if G8RTOS_BootStart was not
+ *    called, as on the host
+ *  - Phases past BOOT_ENTRIES or BOOT_DEPTH are not
+ *    recorded but still have to be ended
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_BootBegin(const char *name);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_BootEnd
+ * INPUTS: void
+ * OUTPUTS: void
+ * Closes the phase opened last
+ *  - Does nothing if no phase is open
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_BootEnd();
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_BootSetClock
+ * INPUTS: (uint32_t) hz
+ * OUTPUTS: void
+ * Tells the profile that MCLK now runs at hz, call it
+ * right after changing the clock
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_BootSetClock(uint32_t hz);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_BootPrint
+ * INPUTS: void
+ * OUTPUTS: void
+ * Writes the boot table to the back channel UART, one
+ * CSV line per phase in the order they began:
+ *   phase,depth,start_us,duration_us
+ *  - Phases still open print their time so far
+ *  - Ends with "#boot_us=" and the time since reset
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_BootPrint();
+
+#else
+
+#define G8RTOS_BootStart()
+#define G8RTOS_BootBegin(name)
+#define G8RTOS_BootEnd()
+#define G8RTOS_BootSetClock(hz)
+#define G8RTOS_BootPrint()
+
+#endif /* G8RTOS_USE_BOOT_PROFILE */
+
+#endif /* G8RTOS_BOOT_H_ */
@@ -0,0 +1,207 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/17/2020                                                |
+ * | SUMMARY: G8RTOS_Config.h                                        |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifndef G8RTOS_CONFIG_H_
+#define G8RTOS_CONFIG_H_
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                        FEATURES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* 1 compiles a feature in, 0 leaves its code and tables out. Code that needs a feature checks for it with #error */
+
+/* periodic events run from SysTick */
+#define G8RTOS_USE_PERIODIC_EVENTS 1
+
+/* earliest deadline first band for periodic threads */
+#define G8RTOS_USE_EDF 1
+
+/* FIFOs, mailboxes, rings, topics and streams */
+#define G8RTOS_USE_IPC 1
+
+/* protothread tasks */
+#define G8RTOS_USE_TASKS 1
+
+/* fixed-size block pools */
+#define G8RTOS_USE_POOL 1
+
+/* variable-size heap, off until something allocates from it */
+#define G8RTOS_USE_HEAP 0
+
+/* trace hooks, the application implements G8RTOS_Trace* */
+#define G8RTOS_USE_TRACE 0
+
+/* per-thread run counters */
+#define G8RTOS_USE_STATS 0
+
+/* round-robin time slices among equal priority threads */
+#define G8RTOS_USE_TIME_SLICE 1
+
+/* per-thread CPU budgets replenished every period */
+#define G8RTOS_USE_BUDGET 1
+
+/* per-pin GPIO interrupt dispatch */
+#define G8RTOS_USE_GPIO 1
+
+/* startup phases timed from Reset_Handler, printed over the back channel UART */
+#define G8RTOS_USE_BOOT_PROFILE 1
+
+/* registry of named counters, gauges and histograms */
+#define G8RTOS_USE_METRICS 1
+
+/* PC-sampling profiler dumped over the back channel UART */
+#ifndef G8RTOS_USE_PROFILER
+#define G8RTOS_USE_PROFILER 0
+#endif
+
+/* kernel benchmarks run instead of the game, set by the bench build */
+#ifndef G8RTOS_USE_BENCH
+#define G8RTOS_USE_BENCH 0
+#endif
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                       SCHEDULER
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* thread control blocks and stacks */
+#define MAX_THREADS 20
+
+/* words of stack per thread */
+#define STACKSIZE 512
+
+/* periodic events */
+#define MAXPTHREADS 6
+
+/* characters kept of each thread name */
+#define MAX_NAME_LENGTH 16
+
+/* priority of SysTick and PendSV */
+#define OSINT_PRIORITY 7
+
+/* priority of the EDF band, lower fixed priorities run above it and higher ones below */
+#define EDF_PRIORITY 128
+
+/* default ms a thread runs before an equal priority peer gets the CPU, 0 never rotates */
+#define TIME_SLICE_MS 10
+
+/* priority a BUDGET_DEMOTE thread runs at until its budget is replenished */
+#define BUDGET_DEMOTE_PRIORITY 253
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                          IPC
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* int32_t elements per index based FIFO */
+#define FIFOSIZE 16
+
+/* index based FIFOs */
+#define MAX_NUMBER_OF_FIFOS 4
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                         TASKS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* tasks multiplexed in the task scheduler thread */
+#define MAX_TASKS 16
+
+/* how often (ms) tasks waiting on a condition are polled */
+#define TASK_POLL_PERIOD 1
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                         GPIO
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* interrupt capable ports, P1 to P6 */
+#define GPIO_PORTS 6
+
+/* priority of the port interrupts, shared by every pin of a port */
+#define GPIO_IRQ_PRIORITY 6
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                         HEAP
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* bytes of SRAM reserved for the heap, multiple of 8 */
+#define HEAP_SIZE 4096
+
+/* log2 of the second level lists per first level class */
+#define HEAP_SL_INDEX_COUNT_LOG2 4
+
+/* log2 of the block alignment */
+#define HEAP_ALIGN_SIZE_LOG2 3
+
+/* log2 of the largest block class, must cover HEAP_SIZE */
+#define HEAP_FL_INDEX_MAX 16
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                         BENCH
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* samples taken per scenario */
+#define BENCH_SAMPLES 1000
+
+/* priority of the benchmark threads */
+#define BENCH_PRIORITY 10
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                        PROFILER
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* samples per second taken by G8RTOS_ProfilerThread */
+#define PROFILER_RATE_HZ 5000
+
+/* samples kept in RAM per window, 8 bytes each on the board */
+#define PROFILER_SAMPLES 512
+
+/* priority of the sampling interrupt, above OSINT_PRIORITY so the kernel is sampled too */
+#define PROFILER_IRQ_PRIORITY 0
+
+/* priority of G8RTOS_ProfilerThread, dumps only run while the game is idle */
+#define PROFILER_THREAD_PRIORITY 250
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                          BOOT
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* phases kept in the boot table, 16 bytes each */
+#define BOOT_ENTRIES 32
+
+/* deepest nesting of boot phases */
+#define BOOT_DEPTH 4
+
+/* MCLK out of reset, until BSP_InitBoard raises it (see __SYSTEM_CLOCK) */
+#define BOOT_RESET_CLOCK_HZ 3000000
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                         METRICS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* bytes of one snapshot record, small enough for one UDP packet */
+#define METRICS_RECORD_SIZE 768
+
+#endif /* G8RTOS_CONFIG_H_ */
@@ -38,4 +38,16 @@ extern int32_t StartCriticalSection();
  */
 extern void EndCriticalSection(int32_t IBit_State);
 
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * AtomicAdd
+ * INPUTS: (volatile uint32_t *) address, (uint32_t) value
+ * OUTPUTS: (uint32_t) new value
+ * Adds value to the word at address without disabling
+ * interrupts
+ *  - LDREX/STREX, retried if another store came between
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+extern uint32_t AtomicAdd(volatile uint32_t *address, uint32_t value);
+
 #endif /* G8RTOS_CRITICALSECTION_H_ */
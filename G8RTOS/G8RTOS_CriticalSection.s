@@ -4,7 +4,7 @@
 ; +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
 
 	; Functions Defined
-	.def StartCriticalSection, EndCriticalSection
+	.def StartCriticalSection, EndCriticalSection, AtomicAdd
 	
 	.thumb		; Set to thumb mode
 	.align 2	; Align by 2 bytes (thumb mode uses allignment by 2 or 4)
@@ -34,3 +34,23 @@ EndCriticalSection:
 	BX LR				; Return
 	
 	.endasmfunc
+
+; Adds to a word without disabling interrupts
+; 	- LDREX/STREX retry until no other store hit the word in between
+; 	- An exception between them clears the reservation, so interrupts are safe
+; Param R0: Address of the word
+; Param R1: Value to add
+; Returns: The new value of the word
+AtomicAdd:
+	.asmfunc
+
+AtomicAddRetry:
+	LDREX R2, [R0]		; Load the word and reserve it
+	ADD R2, R2, R1		; Add the value
+	STREX R3, R2, [R0]	; Store if still reserved, R3 = 0 on success
+	CMP R3, #0
+	BNE AtomicAddRetry	; Lost the reservation, try again
+	MOV R0, R2			; Return the new value
+	BX LR				; Return
+
+	.endasmfunc
@@ -0,0 +1,297 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/21/2020                                                |
+ * | SUMMARY: G8RTOS_GPIO.c                                          |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "G8RTOS_GPIO.h"
+#include "G8RTOS_Port.h"
+#include "G8RTOS_CriticalSection.h"
+#include "G8RTOS_Config.h"
+
+#if G8RTOS_USE_GPIO
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                        DEFINES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* pins per port */
+#define GPIO_PINS 8
+
+/* registers of a port, odd and even ports have different types in msp.h */
+#define GPIO_PORT(P) { &(P)->IN, &(P)->DIR, &(P)->IES, &(P)->IE, &(P)->IFG }
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                  DATA TYPE DEFINITIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * GPIO Port
+ * Byte registers of one port used by the service
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef struct gpioPort {
+    const volatile uint8_t *IN;
+    volatile uint8_t *DIR;
+    volatile uint8_t *IES;
+    volatile uint8_t *IE;
+    volatile uint8_t *IFG;
+} gpioPort_t;
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * GPIO Event
+ * What a pin does when its edge happens. lastEvent is
+ * the SystemTime of the last event that was not
+ * dropped by the debounce
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef struct gpioEvent {
+    void (*handler)(void);
+    semaphore_t *semaphore;
+    uint32_t debounceMS;
+    uint32_t lastEvent;
+    gpioEdge_t edge;
+} gpioEvent_t;
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PRIVATE VARIABLES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* events of every pin */
+static gpioEvent_t GPIOEvents[GPIO_PORTS][GPIO_PINS];
+
+/* registers of P1 to P6 */
+static const gpioPort_t Ports[GPIO_PORTS] = {
+    GPIO_PORT(P1), GPIO_PORT(P2), GPIO_PORT(P3), GPIO_PORT(P4), GPIO_PORT(P5), GPIO_PORT(P6)
+};
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PRIVATE FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* index of the least significant set bit, x can not be 0 */
+static inline uint32_t FindFirstSet(uint32_t x)
+{
+    return __CLZ(__RBIT(x));
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * SetEdge
+ * INPUTS: (const gpioPort_t *) port, (uint8_t) bit,
+ *         (gpioEdge_t) edge
+ * OUTPUTS: void
+ * Selects the edge of a pin, GPIO_EDGE_BOTH waits for
+ * the pin to leave its current level
+ *  - Changing IES can set IFG, clear it afterwards
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void SetEdge(const gpioPort_t *port, uint8_t bit, gpioEdge_t edge)
+{
+    bool falling = (edge == GPIO_EDGE_FALLING) ||
+                   (edge == GPIO_EDGE_BOTH && (*port->IN & bit));
+
+    if (falling) *port->IES |= bit;
+    else *port->IES &= ~bit;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * DispatchPort
+ * INPUTS: (uint32_t) index
+ * OUTPUTS: void
+ * Runs the event of every pending pin of port index,
+ * lowest pin first
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void DispatchPort(uint32_t index)
+{
+    const gpioPort_t *port = &Ports[index];
+    uint32_t pending = *port->IFG & *port->IE;
+
+    while (pending) {
+        uint32_t pin = FindFirstSet(pending);
+        uint8_t bit = 1 << pin;
+        gpioEvent_t *event = &GPIOEvents[index][pin];
+        pending &= pending - 1;
+
+        /* wait for the opposite edge before clearing, so no edge is lost */
+        if (event->edge == GPIO_EDGE_BOTH)
+            SetEdge(port, bit, GPIO_EDGE_BOTH);
+        *port->IFG &= ~bit;
+
+        /* drop bounces */
+        if (event->debounceMS && SystemTime - event->lastEvent < event->debounceMS)
+            continue;
+        event->lastEvent = SystemTime;
+
+        if (event->handler)
+            event->handler();
+        if (event->semaphore)
+            G8RTOS_SignalSemaphore(event->semaphore);
+    }
+}
+
+/* port interrupt handlers */
+static void Port1Handler() { DispatchPort(0); }
+static void Port2Handler() { DispatchPort(1); }
+static void Port3Handler() { DispatchPort(2); }
+static void Port4Handler() { DispatchPort(3); }
+static void Port5Handler() { DispatchPort(4); }
+static void Port6Handler() { DispatchPort(5); }
+
+/* handler of every port */
+static void (* const PortHandlers[GPIO_PORTS])(void) = {
+    Port1Handler, Port2Handler, Port3Handler, Port4Handler, Port5Handler, Port6Handler
+};
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * AddGPIO
+ * INPUTS: (uint8_t) port, (uint8_t) pin,
+ *         (gpioEdge_t) edge, (uint32_t) debounceMS,
+ *         (void)(* handler)(void), (semaphore_t *) s
+ * OUTPUTS: (sched_ErrCode_t) error
+ * Stores the event of a pin and enables its interrupt
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static sched_ErrCode_t AddGPIO(uint8_t port, uint8_t pin, gpioEdge_t edge,
+                               uint32_t debounceMS, void (*handler)(void), semaphore_t *s)
+{
+    /* verify that the pin exists */
+    if (port < 1 || port > GPIO_PORTS || pin >= GPIO_PINS)
+        return PIN_INVALID;
+
+    /* start critical section & disable interrupts */
+    int32_t status = StartCriticalSection();
+
+    const gpioPort_t *regs = &Ports[port - 1];
+    gpioEvent_t *event = &GPIOEvents[port - 1][pin];
+    uint8_t bit = 1 << pin;
+
+    /* store event */
+    event->handler = handler;
+    event->semaphore = s;
+    event->debounceMS = debounceMS;
+    event->lastEvent = SystemTime - debounceMS;
+    event->edge = edge;
+
+    /* input with the requested edge */
+    *regs->IE &= ~bit;
+    *regs->DIR &= ~bit;
+    SetEdge(regs, bit, edge);
+    *regs->IFG &= ~bit;
+    *regs->IE |= bit;
+
+    /* initialize NVIC registers */
+    G8RTOS_PortEnableIRQ((IRQn_Type)(PORT1_IRQn + port - 1), PortHandlers[port - 1], GPIO_IRQ_PRIORITY);
+
+    /* end critical section and enable interrupts */
+    EndCriticalSection(status);
+
+    return NO_ERROR;
+}
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_AddGPIOEvent
+ * INPUTS: (uint8_t) port, (uint8_t) pin,
+ *         (gpioEdge_t) edge, (uint32_t) debounceMS,
+ *         (void)(* handler)(void)
+ * OUTPUTS: (sched_ErrCode_t) error
+ * Runs handler from the port interrupt whenever edge
+ * happens on P<port>.<pin>
+ *  - Makes the pin an input, pull resistors are left
+ *    to the caller
+ *  - Events within debounceMS of the last one are
+ *    dropped, 0 keeps every event
+ *  - Replaces an earlier event of the same pin
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+sched_ErrCode_t G8RTOS_AddGPIOEvent(uint8_t port, uint8_t pin, gpioEdge_t edge,
+                                    uint32_t debounceMS, void (*handler)(void))
+{
+    return AddGPIO(port, pin, edge, debounceMS, handler, 0);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_AddGPIOSemaphore
+ * INPUTS: (uint8_t) port, (uint8_t) pin,
+ *         (gpioEdge_t) edge, (uint32_t) debounceMS,
+ *         (semaphore_t *) s
+ * OUTPUTS: (sched_ErrCode_t) error
+ * Signals s whenever edge happens on P<port>.<pin>, so
+ * a thread can wait for the pin
+ *  - Same rules as G8RTOS_AddGPIOEvent
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+sched_ErrCode_t G8RTOS_AddGPIOSemaphore(uint8_t port, uint8_t pin, gpioEdge_t edge,
+                                        uint32_t debounceMS, semaphore_t *s)
+{
+    return AddGPIO(port, pin, edge, debounceMS, 0, s);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_RemoveGPIOEvent
+ * INPUTS: (uint8_t) port, (uint8_t) pin
+ * OUTPUTS: (sched_ErrCode_t) error
+ * Disables the interrupt of P<port>.<pin> and forgets
+ * its handler or semaphore
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+sched_ErrCode_t G8RTOS_RemoveGPIOEvent(uint8_t port, uint8_t pin)
+{
+    /* verify that the pin exists */
+    if (port < 1 || port > GPIO_PORTS || pin >= GPIO_PINS)
+        return PIN_INVALID;
+
+    /* start critical section & disable interrupts */
+    int32_t status = StartCriticalSection();
+
+    const gpioPort_t *regs = &Ports[port - 1];
+    uint8_t bit = 1 << pin;
+
+    *regs->IE &= ~bit;
+    *regs->IFG &= ~bit;
+    GPIOEvents[port - 1][pin].handler = 0;
+    GPIOEvents[port - 1][pin].semaphore = 0;
+
+    /* end critical section and enable interrupts */
+    EndCriticalSection(status);
+
+    return NO_ERROR;
+}
+
+#endif /* G8RTOS_USE_GPIO */
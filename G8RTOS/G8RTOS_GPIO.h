@@ -0,0 +1,106 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/21/2020                                                |
+ * | SUMMARY: G8RTOS_GPIO.h                                          |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifndef G8RTOS_GPIO_H_
+#define G8RTOS_GPIO_H_
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include "G8RTOS_Config.h"
+#include "G8RTOS_Semaphores.h"
+#include "G8RTOS_Scheduler.h"
+
+#if G8RTOS_USE_GPIO
+
+/*
+ * The GPIO service owns the port interrupt vectors. Each
+ * pin gets its own handler or semaphore, so drivers can
+ * share a port without knowing about each other
+ */
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                  DATA TYPE DEFINITIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * GPIO edge typedef
+ * Transition of the pin that raises an event
+ *  - GPIO_EDGE_BOTH flips the edge after every event
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef enum {
+    GPIO_EDGE_RISING = 0,
+    GPIO_EDGE_FALLING = 1,
+    GPIO_EDGE_BOTH = 2
+} gpioEdge_t;
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_AddGPIOEvent
+ * INPUTS: (uint8_t) port, (uint8_t) pin,
+ *         (gpioEdge_t) edge, (uint32_t) debounceMS,
+ *         (void)(* handler)(void)
+ * OUTPUTS: (sched_ErrCode_t) error
+ * Runs handler from the port interrupt whenever edge
+ * happens on P<port>.<pin>
+ *  - Makes the pin an input, pull resistors are left
+ *    to the caller
+ *  - Events within debounceMS of the last one are
+ *    dropped, 0 keeps every event
+ *  - Replaces an earlier event of the same pin
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+sched_ErrCode_t G8RTOS_AddGPIOEvent(uint8_t port, uint8_t pin, gpioEdge_t edge,
+                                    uint32_t debounceMS, void (*handler)(void));
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_AddGPIOSemaphore
+ * INPUTS: (uint8_t) port, (uint8_t) pin,
+ *         (gpioEdge_t) edge, (uint32_t) debounceMS,
+ *         (semaphore_t *) s
+ * OUTPUTS: (sched_ErrCode_t) error
+ * Signals s whenever edge happens on P<port>.<pin>, so
+ * a thread can wait for the pin
+ *  - Same rules as G8RTOS_AddGPIOEvent
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+sched_ErrCode_t G8RTOS_AddGPIOSemaphore(uint8_t port, uint8_t pin, gpioEdge_t edge,
+                                        uint32_t debounceMS, semaphore_t *s);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_RemoveGPIOEvent
+ * INPUTS: (uint8_t) port, (uint8_t) pin
+ * OUTPUTS: (sched_ErrCode_t) error
+ * Disables the interrupt of P<port>.<pin> and forgets
+ * its handler or semaphore
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+sched_ErrCode_t G8RTOS_RemoveGPIOEvent(uint8_t port, uint8_t pin);
+
+#endif /* G8RTOS_USE_GPIO */
+
+#endif /* G8RTOS_GPIO_H_ */
@@ -0,0 +1,526 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/09/2020                                                |
+ * | SUMMARY: G8RTOS_Heap.c                                          |
+ * | Two-level segregated fit (TLSF) allocator. Free blocks are      |
+ * | binned by a power of two (first level) split in linear ranges   |
+ * | (second level). Two bitmaps tell which bins are non-empty, so   |
+ * | finding and freeing a block is a couple of CLZ instructions.    |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "msp.h"
+#include "G8RTOS_Heap.h"
+#include "G8RTOS_Semaphores.h"
+#include "G8RTOS_Config.h"
+
+#if G8RTOS_USE_HEAP
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                        DEFINES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#define SL_INDEX_COUNT (1 << HEAP_SL_INDEX_COUNT_LOG2)
+#define ALIGN_SIZE (1 << HEAP_ALIGN_SIZE_LOG2)
+#define FL_INDEX_SHIFT (HEAP_SL_INDEX_COUNT_LOG2 + HEAP_ALIGN_SIZE_LOG2)
+#define FL_INDEX_COUNT (HEAP_FL_INDEX_MAX - FL_INDEX_SHIFT + 1)
+#define SMALL_BLOCK_SIZE (1 << FL_INDEX_SHIFT)
+
+/* size bit marking a free block, sizes are multiples of ALIGN_SIZE */
+#define BLOCK_FREE 0x1
+
+#if HEAP_SIZE > (1 << HEAP_FL_INDEX_MAX)
+#error "HEAP_FL_INDEX_MAX is too small for HEAP_SIZE"
+#endif
+
+#if HEAP_SIZE % ALIGN_SIZE
+#error "HEAP_SIZE must be a multiple of the alignment"
+#endif
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                  DATA STRUCTURES USED
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Heap block typedef
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef struct heapBlock heapBlock_t;
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Heap block
+ * Header in front of every block. size is the payload
+ * size with the free bit. The free list pointers
+ * overlay the payload, so they only exist while the
+ * block is free
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+struct heapBlock {
+    struct heapBlock *prevPhysical;
+    uint32_t size;
+    struct heapBlock *nextFree;
+    struct heapBlock *prevFree;
+};
+
+/* bytes in front of every payload (prevPhysical & size) */
+#define BLOCK_HEADER_SIZE offsetof(heapBlock_t, nextFree)
+
+/* smallest payload, a free block stores its list pointers in it */
+#define BLOCK_SIZE_MIN (sizeof(heapBlock_t) - BLOCK_HEADER_SIZE)
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Heap Memory
+ * Backing store of the heap, 8 byte aligned
+ *  - The sentinel header sits in the last bytes of
+ *    HEAP_SIZE, the array is a full block longer so
+ *    the sentinel is a whole heapBlock_t in bounds
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static uint64_t heapMemory[(HEAP_SIZE + sizeof(heapBlock_t)) / sizeof(uint64_t)];
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Free Lists
+ * Heads of the segregated free lists
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static heapBlock_t *freeLists[FL_INDEX_COUNT][SL_INDEX_COUNT];
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PRIVATE VARIABLES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* bit per first level class with a non-empty list */
+static uint32_t flBitmap;
+
+/* bit per second level list that is non-empty */
+static uint32_t slBitmap[FL_INDEX_COUNT];
+
+/* mutual exclusion of heap threads */
+static semaphore_t HeapMutex;
+
+/* bytes in allocated blocks (headers included) */
+static uint32_t UsedBytes;
+
+/* most bytes ever allocated at once */
+static uint32_t PeakUsedBytes;
+
+/* number of successful allocations */
+static uint32_t Allocations;
+
+/* number of failed allocations */
+static uint32_t Failures;
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PRIVATE FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* index of the most significant set bit, x can not be 0 */
+static inline int FindLastSet(uint32_t x)
+{
+    return 31 - __CLZ(x);
+}
+
+/* index of the least significant set bit, x can not be 0 */
+static inline int FindFirstSet(uint32_t x)
+{
+    return __CLZ(__RBIT(x));
+}
+
+/* payload size of a block */
+static inline uint32_t BlockSize(heapBlock_t *block)
+{
+    return block->size & ~BLOCK_FREE;
+}
+
+/* block physically following block */
+static inline heapBlock_t *NextPhysical(heapBlock_t *block)
+{
+    return (heapBlock_t *)((uint8_t *)block + BLOCK_HEADER_SIZE + BlockSize(block));
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * MappingInsert
+ * INPUTS: (uint32_t) size, (int *) fl, (int *) sl
+ * OUTPUTS: void
+ * Computes the free list a block of size belongs to
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void MappingInsert(uint32_t size, int *fl, int *sl)
+{
+    /* small blocks are split linearly in the first class */
+    if (size < SMALL_BLOCK_SIZE) {
+        *fl = 0;
+        *sl = size >> HEAP_ALIGN_SIZE_LOG2;
+    }
+    else {
+        int f = FindLastSet(size);
+        *sl = (size >> (f - HEAP_SL_INDEX_COUNT_LOG2)) ^ SL_INDEX_COUNT;
+        *fl = f - (FL_INDEX_SHIFT - 1);
+    }
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * MappingSearch
+ * INPUTS: (uint32_t) size, (int *) fl, (int *) sl
+ * OUTPUTS: void
+ * Computes the first free list whose every block is at
+ * least size bytes by rounding size up to the next list
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void MappingSearch(uint32_t size, int *fl, int *sl)
+{
+    if (size >= SMALL_BLOCK_SIZE)
+        size += (1 << (FindLastSet(size) - HEAP_SL_INDEX_COUNT_LOG2)) - 1;
+
+    MappingInsert(size, fl, sl);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * FindSuitableBlock
+ * INPUTS: (int *) fl, (int *) sl
+ * OUTPUTS: (heapBlock_t *) block
+ * Finds the first non-empty list at or above fl/sl
+ *  - Updates fl/sl to the list the block was found in
+ *  - Returns 0 if no list is large enough
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static heapBlock_t *FindSuitableBlock(int *fl, int *sl)
+{
+    /* search the remaining lists of the same class */
+    uint32_t slMap = slBitmap[*fl] & (~0U << *sl);
+
+    /* otherwise take the first list of a larger class */
+    if (!slMap) {
+        uint32_t flMap = (*fl + 1 < 32) ? flBitmap & (~0U << (*fl + 1)) : 0;
+
+        if (!flMap)
+            return 0;
+
+        *fl = FindFirstSet(flMap);
+        slMap = slBitmap[*fl];
+    }
+
+    *sl = FindFirstSet(slMap);
+
+    return freeLists[*fl][*sl];
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * RemoveFreeBlock
+ * INPUTS: (heapBlock_t *) block, (int) fl, (int) sl
+ * OUTPUTS: void
+ * Unlinks a block from free list fl/sl
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void RemoveFreeBlock(heapBlock_t *block, int fl, int sl)
+{
+    if (block->nextFree)
+        block->nextFree->prevFree = block->prevFree;
+    if (block->prevFree)
+        block->prevFree->nextFree = block->nextFree;
+
+    /* block was the head, clear bitmaps if the list is now empty */
+    if (freeLists[fl][sl] == block) {
+        freeLists[fl][sl] = block->nextFree;
+
+        if (!freeLists[fl][sl]) {
+            slBitmap[fl] &= ~(1U << sl);
+
+            if (!slBitmap[fl])
+                flBitmap &= ~(1U << fl);
+        }
+    }
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * InsertFreeBlock
+ * INPUTS: (heapBlock_t *) block
+ * OUTPUTS: void
+ * Marks a block free and links it in its free list
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void InsertFreeBlock(heapBlock_t *block)
+{
+    int fl, sl;
+    MappingInsert(BlockSize(block), &fl, &sl);
+
+    block->size |= BLOCK_FREE;
+    block->prevFree = 0;
+    block->nextFree = freeLists[fl][sl];
+
+    if (block->nextFree)
+        block->nextFree->prevFree = block;
+
+    freeLists[fl][sl] = block;
+    flBitmap |= 1U << fl;
+    slBitmap[fl] |= 1U << sl;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * RemoveBlock
+ * INPUTS: (heapBlock_t *) block
+ * OUTPUTS: void
+ * Unlinks a free block from the list its size maps to
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void RemoveBlock(heapBlock_t *block)
+{
+    int fl, sl;
+    MappingInsert(BlockSize(block), &fl, &sl);
+    RemoveFreeBlock(block, fl, sl);
+}
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_InitHeap
+ * INPUTS: void
+ * OUTPUTS: void
+ * Initializes the heap as a single free block
+ *  - Must be called before any thread uses the heap
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_InitHeap()
+{
+    /* clear free lists */
+    flBitmap = 0;
+    for (int fl = 0; fl < FL_INDEX_COUNT; fl++) {
+        slBitmap[fl] = 0;
+        for (int sl = 0; sl < SL_INDEX_COUNT; sl++)
+            freeLists[fl][sl] = 0;
+    }
+
+    /* one free block spans the heap, minus the sentinel header */
+    heapBlock_t *block = (heapBlock_t *)heapMemory;
+    block->prevPhysical = 0;
+    block->size = HEAP_SIZE - 2 * BLOCK_HEADER_SIZE;
+
+    /* zero-sized used sentinel stops merges at the end of the heap */
+    heapBlock_t *sentinel = NextPhysical(block);
+    sentinel->prevPhysical = block;
+    sentinel->size = 0;
+
+    InsertFreeBlock(block);
+
+    /* clear statistics, the sentinel is always in use */
+    UsedBytes = BLOCK_HEADER_SIZE;
+    PeakUsedBytes = UsedBytes;
+    Allocations = 0;
+    Failures = 0;
+
+    /* initialize mutex semaphore */
+    G8RTOS_InitSemaphore(&HeapMutex, 1);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_HeapAlloc
+ * INPUTS: (uint32_t) size
+ * OUTPUTS: (void *) memory
+ * Allocates size bytes from the heap in O(1)
+ *  - Memory is 8 byte aligned
+ *  - Returns 0 and counts a failure if no free block
+ *    is large enough
+ *  - Threads only, never call from an ISR
+ *  - Guarded by the heap mutex
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void *G8RTOS_HeapAlloc(uint32_t size)
+{
+    /* reject empty and impossible requests */
+    if (size == 0 || size > HEAP_SIZE)
+        return 0;
+
+    /* round size up to the alignment */
+    size = (size + ALIGN_SIZE - 1) & ~(ALIGN_SIZE - 1);
+    if (size < BLOCK_SIZE_MIN)
+        size = BLOCK_SIZE_MIN;
+
+    /* wait until heap is available */
+    G8RTOS_WaitSemaphore(&HeapMutex);
+
+    /* find a list whose blocks all fit size */
+    int fl, sl;
+    MappingSearch(size, &fl, &sl);
+
+    heapBlock_t *block = (fl < FL_INDEX_COUNT) ? FindSuitableBlock(&fl, &sl) : 0;
+
+    /* count failure if no block is large enough */
+    if (!block) {
+        Failures++;
+        G8RTOS_SignalSemaphore(&HeapMutex);
+        return 0;
+    }
+
+    RemoveFreeBlock(block, fl, sl);
+
+    /* split off the tail if it can hold another block */
+    uint32_t blockSize = BlockSize(block);
+    if (blockSize - size >= BLOCK_HEADER_SIZE + BLOCK_SIZE_MIN) {
+        heapBlock_t *remaining = (heapBlock_t *)((uint8_t *)block + BLOCK_HEADER_SIZE + size);
+        remaining->prevPhysical = block;
+        remaining->size = blockSize - size - BLOCK_HEADER_SIZE;
+        NextPhysical(remaining)->prevPhysical = remaining;
+
+        blockSize = size;
+        InsertFreeBlock(remaining);
+    }
+
+    /* mark block used */
+    block->size = blockSize;
+
+    /* update statistics */
+    UsedBytes += BLOCK_HEADER_SIZE + blockSize;
+    if (UsedBytes > PeakUsedBytes)
+        PeakUsedBytes = UsedBytes;
+    Allocations++;
+
+    /* release heap semaphore */
+    G8RTOS_SignalSemaphore(&HeapMutex);
+
+    /* payload starts after the header */
+    return (uint8_t *)block + BLOCK_HEADER_SIZE;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_HeapFree
+ * INPUTS: (void *) memory
+ * OUTPUTS: (int) error
+ * Returns memory to the heap in O(1)
+ *  - Merges the block with free neighbours
+ *  - Returns -1 if memory is outside of the heap or
+ *    already free
+ *  - Threads only, never call from an ISR
+ *  - Guarded by the heap mutex
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_HeapFree(void *memory)
+{
+    heapBlock_t *block = (heapBlock_t *)((uint8_t *)memory - BLOCK_HEADER_SIZE);
+
+    /* return error code if memory is outside of the heap or misaligned */
+    if ((uint8_t *)block < (uint8_t *)heapMemory ||
+        (uint8_t *)block >= (uint8_t *)heapMemory + HEAP_SIZE - BLOCK_HEADER_SIZE ||
+        ((uintptr_t)memory & (ALIGN_SIZE - 1)))
+        return -1;
+
+    /* wait until heap is available */
+    G8RTOS_WaitSemaphore(&HeapMutex);
+
+    /* return error code on double free */
+    if (block->size & BLOCK_FREE) {
+        G8RTOS_SignalSemaphore(&HeapMutex);
+        return -1;
+    }
+
+    /* update statistics */
+    UsedBytes -= BLOCK_HEADER_SIZE + BlockSize(block);
+
+    /* mark block free, the header stays marked even once merged away */
+    block->size |= BLOCK_FREE;
+
+    /* merge with the previous block if it is free */
+    heapBlock_t *prev = block->prevPhysical;
+    if (prev && (prev->size & BLOCK_FREE)) {
+        RemoveBlock(prev);
+        prev->size = BlockSize(prev) + BLOCK_HEADER_SIZE + BlockSize(block);
+        NextPhysical(prev)->prevPhysical = prev;
+        block = prev;
+    }
+
+    /* merge with the next block if it is free */
+    heapBlock_t *next = NextPhysical(block);
+    if (next->size & BLOCK_FREE) {
+        RemoveBlock(next);
+        block->size = BlockSize(block) + BLOCK_HEADER_SIZE + BlockSize(next);
+        NextPhysical(block)->prevPhysical = block;
+    }
+
+    InsertFreeBlock(block);
+
+    /* release heap semaphore */
+    G8RTOS_SignalSemaphore(&HeapMutex);
+
+    /* return error code */
+    return 1;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_HeapGetStats
+ * INPUTS: (heapStats_t *) stats
+ * OUTPUTS: void
+ * Fills stats with the current heap usage
+ *  - Walks every block, meant for diagnostics only
+ *  - Guarded by the heap mutex
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_HeapGetStats(heapStats_t *stats)
+{
+    /* wait until heap is available */
+    G8RTOS_WaitSemaphore(&HeapMutex);
+
+    stats->totalBytes = HEAP_SIZE;
+    stats->usedBytes = UsedBytes;
+    stats->peakUsedBytes = PeakUsedBytes;
+    stats->freeBytes = 0;
+    stats->largestFreeBlock = 0;
+    stats->freeBlocks = 0;
+    stats->allocations = Allocations;
+    stats->failures = Failures;
+
+    /* walk physical blocks up to the sentinel */
+    for (heapBlock_t *block = (heapBlock_t *)heapMemory; BlockSize(block) != 0; block = NextPhysical(block)) {
+        if (block->size & BLOCK_FREE) {
+            stats->freeBytes += BLOCK_HEADER_SIZE + BlockSize(block);
+            stats->freeBlocks++;
+
+            if (BlockSize(block) > stats->largestFreeBlock)
+                stats->largestFreeBlock = BlockSize(block);
+        }
+    }
+
+    /* share of free memory unusable for the largest request */
+    if (stats->freeBytes)
+        stats->fragmentation = 100 - (100 * (stats->largestFreeBlock + BLOCK_HEADER_SIZE)) / stats->freeBytes;
+    else
+        stats->fragmentation = 0;
+
+    /* release heap semaphore */
+    G8RTOS_SignalSemaphore(&HeapMutex);
+}
+
+#endif /* G8RTOS_USE_HEAP */
@@ -0,0 +1,114 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/09/2020                                                |
+ * | SUMMARY: G8RTOS_Heap.h                                          |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifndef G8RTOS_HEAP_H_
+#define G8RTOS_HEAP_H_
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "G8RTOS_Config.h"
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                  DATA TYPE DEFINITIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Heap statistics typedef
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef struct heapStats heapStats_t;
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Heap statistics
+ * Snapshot of heap usage. Byte counts include block
+ * headers. fragmentation is the percentage of free
+ * memory that is not part of the largest free block
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+struct heapStats {
+    uint32_t totalBytes;
+    uint32_t usedBytes;
+    uint32_t peakUsedBytes;
+    uint32_t freeBytes;
+    uint32_t largestFreeBlock;
+    uint32_t freeBlocks;
+    uint32_t allocations;
+    uint32_t failures;
+    uint8_t fragmentation;
+};
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_InitHeap
+ * INPUTS: void
+ * OUTPUTS: void
+ * Initializes the heap as a single free block
+ *  - Must be called before any thread uses the heap
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_InitHeap();
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_HeapAlloc
+ * INPUTS: (uint32_t) size
+ * OUTPUTS: (void *) memory
+ * Allocates size bytes from the heap in O(1)
+ *  - Memory is 8 byte aligned
+ *  - Returns 0 and counts a failure if no free block
+ *    is large enough
+ *  - Threads only, never call from an ISR
+ *  - Guarded by the heap mutex
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void *G8RTOS_HeapAlloc(uint32_t size);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_HeapFree
+ * INPUTS: (void *) memory
+ * OUTPUTS: (int) error
+ * Returns memory to the heap in O(1)
+ *  - Merges the block with free neighbours
+ *  - Returns -1 if memory is outside of the heap or
+ *    already free
+ *  - Threads only, never call from an ISR
+ *  - Guarded by the heap mutex
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_HeapFree(void *memory);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_HeapGetStats
+ * INPUTS: (heapStats_t *) stats
+ * OUTPUTS: void
+ * Fills stats with the current heap usage
+ *  - Walks every block, meant for diagnostics only
+ *  - Guarded by the heap mutex
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_HeapGetStats(heapStats_t *stats);
+
+#endif /* G8RTOS_HEAP_H_ */
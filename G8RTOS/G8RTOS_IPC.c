@@ -14,57 +14,130 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 #include "msp.h"
 #include "G8RTOS_Semaphores.h"
+#include "G8RTOS_CriticalSection.h"
 #include "G8RTOS_IPC.h"
+#include "G8RTOS_Config.h"
+#include "G8RTOS_Metrics.h"
+
+#if G8RTOS_USE_IPC
 
 /*
  * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
- *                        DEFINES
+ *                  DATA STRUCTURES USED
  * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
  */
 
-#define FIFOSIZE 16
-#define MAX_NUMBER_OF_FIFOS 4
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * FIFOs
+ * An array of int32_t FIFOs for the index based API
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static fifo_t FIFOs[MAX_NUMBER_OF_FIFOS];
+static uint32_t FIFOBuffers[MAX_NUMBER_OF_FIFOS][FIFOSIZE];
+
+/* elements lost by every FIFO, the sum of their lostData */
+G8RTOS_COUNTER(FIFOLostData, "fifo.lost");
 
 /*
  * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
- *                  DATA STRUCTURES USED
+ *                    PRIVATE FUNCTIONS
  * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
  */
 
 /*
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
- * FIFO typedef
+ * ClaimAvailable
+ * INPUTS: (semaphore_t *) s, (uint32_t) max
+ * OUTPUTS: (uint32_t) claimed
+ * Takes up to max counts of s without blocking
+ *  - Must be called inside a critical section
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static uint32_t ClaimAvailable(semaphore_t *s, uint32_t max)
+{
+    /* nothing to claim if no count is left */
+    if ((*s) <= 0)
+        return 0;
+
+    uint32_t claimed = ((uint32_t)(*s) < max) ? (uint32_t)(*s) : max;
+    (*s) -= claimed;
+
+    return claimed;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * CopyOut
+ * INPUTS: (fifo_t *) fifo, (uint8_t *) data,
+ *         (uint32_t) n
+ * OUTPUTS: void
+ * Removes n elements from head into data
+ *  - Must be called inside a critical section
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  */
-typedef struct FIFO FIFO_t;
+static void CopyOut(fifo_t *fifo, uint8_t *data, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        /* read element from head */
+        memcpy(data, &fifo->buffer[fifo->head * fifo->elementSize], fifo->elementSize);
+        data += fifo->elementSize;
+
+        /* increment head (wrap if necessary) */
+        if (++fifo->head == fifo->depth)
+            fifo->head = 0;
+    }
+
+    fifo->count -= n;
+}
 
 /*
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
- * FIFO
- * The FIFO structure holds the FIFO buffer and
- * information pertinent to the FIFO such as the head
- * and tail pointers, a lost data counter, and semaphores
- * for current size and mutual exclusion
+ * CopyIn
+ * INPUTS: (fifo_t *) fifo, (const uint8_t *) data,
+ *         (uint32_t) n
+ * OUTPUTS: void
+ * Appends n elements from data at the tail
+ *  - The FIFO must have room for n elements
+ *  - Must be called inside a critical section
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  */
-struct FIFO {
-    int32_t buffer[FIFOSIZE];
-    int32_t *head;
-    int32_t *tail;
-    uint32_t lostData;
-    semaphore_t currentSize;
-    semaphore_t mutex;
-};
+static void CopyIn(fifo_t *fifo, const uint8_t *data, uint32_t n)
+{
+    /* tail is count elements past head */
+    uint32_t tail = fifo->head + fifo->count;
+    if (tail >= fifo->depth)
+        tail -= fifo->depth;
+
+    for (uint32_t i = 0; i < n; i++) {
+        /* write element to tail */
+        memcpy(&fifo->buffer[tail * fifo->elementSize], data, fifo->elementSize);
+        data += fifo->elementSize;
+
+        /* increment tail (wrap if necessary) */
+        if (++tail == fifo->depth)
+            tail = 0;
+    }
+
+    fifo->count += n;
+}
 
 /*
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
- * FIFOs
- * An array of FIFOs
+ * SignalMany
+ * INPUTS: (semaphore_t *) s, (uint32_t) n
+ * OUTPUTS: void
+ * Signals s n times, waking up to n blocked threads
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  */
-static FIFO_t FIFOs[MAX_NUMBER_OF_FIFOS];
+static void SignalMany(semaphore_t *s, uint32_t n)
+{
+    while (n--)
+        G8RTOS_SignalSemaphore(s);
+}
 
 /*
  * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
@@ -74,39 +147,195 @@ static FIFO_t FIFOs[MAX_NUMBER_OF_FIFOS];
 
 /*
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
- * G8RTOS_InitFIFO
- * INPUTS: (uint32_t) FIFOIndex
+ * G8RTOS_CreateFIFO
+ * INPUTS: (fifo_t *) fifo, (uint32_t *) storage,
+ *         (uint32_t) elementSize, (uint32_t) depth,
+ *         (fifoPolicy_t) policy, (uint32_t) timeoutMS
  * OUTPUTS: (int) error
- * Initializes FIFO struct
+ * Initializes an empty FIFO over static storage
+ *  - storage must hold FIFO_STORAGE_WORDS(elementSize,
+ *    depth) words
+ *  - timeoutMS is only used by FIFO_BLOCK writers
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  */
-int G8RTOS_InitFIFO(uint32_t FIFOIndex)
+int G8RTOS_CreateFIFO(fifo_t *fifo, uint32_t *storage, uint32_t elementSize,
+                      uint32_t depth, fifoPolicy_t policy, uint32_t timeoutMS)
 {
-    /* return error code if FIFOIndex invalid */
-    if (FIFOIndex > MAX_NUMBER_OF_FIFOS - 1)
+    /* return error code if FIFO is empty */
+    if (elementSize == 0 || depth == 0)
         return -1;
 
-    /* clear FIFO buffer */
-    for (int i = 0; i < FIFOSIZE; i++)
-        FIFOs[FIFOIndex].buffer[i] = 0;
+    /* assign default values to FIFO properties */
+    fifo->buffer = (uint8_t *)storage;
+    fifo->elementSize = elementSize;
+    fifo->depth = depth;
+    fifo->head = 0;
+    fifo->count = 0;
+    fifo->policy = policy;
+    fifo->timeoutMS = timeoutMS;
+
+    /* clear lost data */
+    fifo->lostData = 0;
+    G8RTOS_RegisterMetric(&FIFOLostData);
 
-    /* set head of FIFO */
-    FIFOs[FIFOIndex].head = &FIFOs[FIFOIndex].buffer[0];
+    /* FIFO starts empty */
+    G8RTOS_InitSemaphore(&fifo->currentSize, 0);
+    G8RTOS_InitSemaphore(&fifo->spaces, depth);
 
-    /* set tail of FIFO */
-    FIFOs[FIFOIndex].tail = &FIFOs[FIFOIndex].buffer[0];
+    /* return error code */
+    return 1;
+}
 
-    /* initialize currentSize semaphore */
-    G8RTOS_InitSemaphore(&FIFOs[FIFOIndex].currentSize, 0);
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * readFIFOMany
+ * INPUTS: (fifo_t *) fifo, (void *) data,
+ *         (uint32_t) count, (uint32_t) timeoutMS
+ * OUTPUTS: (uint32_t) elements read
+ * Reads up to count elements into data
+ * - Waits at most timeoutMS for the first element, then
+ *   takes every other available element up to count
+ * - All elements are copied in one critical section
+ * - A timeout of 0 never blocks and is safe from ISRs
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t readFIFOMany(fifo_t *fifo, void *data, uint32_t count, uint32_t timeoutMS)
+{
+    /* nothing to read */
+    if (count == 0)
+        return 0;
 
-    /* initialize mutex semaphore */
-    G8RTOS_InitSemaphore(&FIFOs[FIFOIndex].mutex, 1);
+    /* claim the first element */
+    if (!G8RTOS_WaitSemaphoreTimeout(&fifo->currentSize, timeoutMS))
+        return 0;
 
-    /* clear lost data */
-    FIFOs[FIFOIndex].lostData = 0;
+    /* start critical section & disable interrupts */
+    int32_t status = StartCriticalSection();
 
-    /* return error code */
-    return 1;
+    /* claim every other available element and read them */
+    uint32_t n = 1 + ClaimAvailable(&fifo->currentSize, count - 1);
+    CopyOut(fifo, (uint8_t *)data, n);
+
+    /* wake up blocked writers */
+    if (fifo->policy == FIFO_BLOCK)
+        SignalMany(&fifo->spaces, n);
+
+    /* end critical section and enable interrupts */
+    EndCriticalSection(status);
+
+    return n;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * writeFIFOMany
+ * INPUTS: (fifo_t *) fifo, (const void *) data,
+ *         (uint32_t) count
+ * OUTPUTS: (uint32_t) elements written
+ * Writes count elements from data
+ * - Full FIFOs follow the FIFO overflow policy
+ * - FIFO_BLOCK writes free slots in one critical section
+ *   each time space frees up, other policies write all
+ *   elements in one critical section
+ * - Safe from ISRs unless the policy is FIFO_BLOCK
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t writeFIFOMany(fifo_t *fifo, const void *data, uint32_t count)
+{
+    const uint8_t *src = (const uint8_t *)data;
+    uint32_t written = 0;
+    int32_t status;
+
+    /* blocking writers claim slots as readers free them */
+    if (fifo->policy == FIFO_BLOCK) {
+        while (written < count) {
+            /* wait for the first free slot */
+            if (!G8RTOS_WaitSemaphoreTimeout(&fifo->spaces, fifo->timeoutMS)) {
+                /* start critical section & disable interrupts */
+                status = StartCriticalSection();
+
+                /* elements that did not fit in time are lost */
+                fifo->lostData += count - written;
+                G8RTOS_MetricAdd(&FIFOLostData, count - written);
+
+                /* end critical section and enable interrupts */
+                EndCriticalSection(status);
+
+                break;
+            }
+
+            /* start critical section & disable interrupts */
+            status = StartCriticalSection();
+
+            /* claim every other free slot and fill them */
+            uint32_t n = 1 + ClaimAvailable(&fifo->spaces, count - written - 1);
+            CopyIn(fifo, src + written * fifo->elementSize, n);
+
+            /* wake up blocked readers */
+            SignalMany(&fifo->currentSize, n);
+
+            /* end critical section and enable interrupts */
+            EndCriticalSection(status);
+
+            written += n;
+        }
+
+        return written;
+    }
+
+    /* start critical section & disable interrupts */
+    status = StartCriticalSection();
+
+    /* write as many elements as fit */
+    written = fifo->depth - fifo->count;
+    if (written > count)
+        written = count;
+    CopyIn(fifo, src, written);
+
+    /* wake up blocked readers */
+    SignalMany(&fifo->currentSize, written);
+
+    /* handle lost data */
+    if (fifo->policy == FIFO_DROP_NEWEST) {
+        fifo->lostData += count - written;
+        G8RTOS_MetricAdd(&FIFOLostData, count - written);
+    }
+    else {
+        /* replace the oldest element with each remaining one */
+        for (; written < count; written++) {
+            if (++fifo->head == fifo->depth)
+                fifo->head = 0;
+            fifo->count--;
+
+            CopyIn(fifo, src + written * fifo->elementSize, 1);
+            fifo->lostData++;
+            G8RTOS_MetricAdd(&FIFOLostData, 1);
+        }
+    }
+
+    /* end critical section and enable interrupts */
+    EndCriticalSection(status);
+
+    return written;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_InitFIFO
+ * INPUTS: (uint32_t) FIFOIndex
+ * OUTPUTS: (int) error
+ * Initializes FIFO struct
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_InitFIFO(uint32_t FIFOIndex)
+{
+    /* return error code if FIFOIndex invalid */
+    if (FIFOIndex > MAX_NUMBER_OF_FIFOS - 1)
+        return -1;
+
+    /* int32_t FIFO that drops data when full */
+    return G8RTOS_CreateFIFO(&FIFOs[FIFOIndex], FIFOBuffers[FIFOIndex], sizeof(int32_t),
+                             FIFOSIZE, FIFO_DROP_NEWEST, 0);
 }
 
 /*
@@ -123,26 +352,48 @@ int G8RTOS_InitFIFO(uint32_t FIFOIndex)
  */
 uint32_t readFIFO(uint32_t FIFOChoice)
 {
-    /* decrement currentSize semaphore for current FIFO */
-    G8RTOS_WaitSemaphore(&FIFOs[FIFOChoice].currentSize);
+    uint32_t data;
 
-    /* wait until FIFO is available */
-    G8RTOS_WaitSemaphore(&FIFOs[FIFOChoice].mutex);
+    /* wait for and read one element */
+    readFIFOMany(&FIFOs[FIFOChoice], &data, 1, G8RTOS_WAIT_FOREVER);
 
-    /* read data from head */
-    uint32_t data = *FIFOs[FIFOChoice].head;
+    /* return data */
+    return data;
+}
 
-    /* increment head (wrap if necessary) */
-    if (FIFOs[FIFOChoice].head == &FIFOs[FIFOChoice].buffer[FIFOSIZE - 1])
-        FIFOs[FIFOChoice].head = &FIFOs[FIFOChoice].buffer[0];
-    else
-        FIFOs[FIFOChoice].head++;
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * tryReadFIFO
+ * INPUTS: (uint32_t) FIFOChoice, (uint32_t *) data
+ * OUTPUTS: (int) error
+ * Reads FIFO without blocking
+ * - Returns -1 immediately if the FIFO is empty
+ * - Otherwise stores data from head, increments the
+ *   head ptr (wraps if necessary) and returns 1
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int tryReadFIFO(uint32_t FIFOChoice, uint32_t *data)
+{
+    /* return error code if FIFO is empty */
+    if (readFIFOMany(&FIFOs[FIFOChoice], data, 1, 0) == 0)
+        return -1;
 
-    /* release FIFO semaphore */
-    G8RTOS_SignalSemaphore(&FIFOs[FIFOChoice].mutex);
+    /* return error code */
+    return 1;
+}
 
-    /* return data */
-    return data;
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * FIFOSemaphore
+ * INPUTS: (uint32_t) FIFOChoice
+ * OUTPUTS: (semaphore_t *) currentSize
+ * Gets the semaphore counting the elements of FIFO, to
+ * wait for it with G8RTOS_Select
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+semaphore_t *FIFOSemaphore(uint32_t FIFOChoice)
+{
+    return &FIFOs[FIFOChoice].currentSize;
 }
 
 /*
@@ -158,36 +409,12 @@ uint32_t readFIFO(uint32_t FIFOChoice)
  */
 int writeFIFO(uint32_t FIFOChoice, uint32_t Data)
 {
-    /* wait until FIFO is available */
-    //G8RTOS_WaitSemaphore(&FIFOs[FIFOChoice].mutex);
-
-    /* handle lost data */
-    if (FIFOs[FIFOChoice].currentSize == FIFOSIZE) {
-        /* increment lost data if FIFO size exceeds max */
-        FIFOs[FIFOChoice].lostData++;
-
-        /* release FIFO semaphore */
-        G8RTOS_SignalSemaphore(&FIFOs[FIFOChoice].mutex);
-
-        /* return error code */
+    /* return error code if FIFO is full, data is counted as lost */
+    if (writeFIFOMany(&FIFOs[FIFOChoice], &Data, 1) == 0)
         return -1;
-    }
-
-    /* write data to tail */
-    *FIFOs[FIFOChoice].tail = Data;
-
-    /* increment tail (wrap if necessary) */
-    if (FIFOs[FIFOChoice].tail == &FIFOs[FIFOChoice].buffer[FIFOSIZE - 1])
-        FIFOs[FIFOChoice].tail = &FIFOs[FIFOChoice].buffer[0];
-    else
-        FIFOs[FIFOChoice].tail++;
-
-    /* increment currentSize semaphore for current FIFO */
-    G8RTOS_SignalSemaphore(&FIFOs[FIFOChoice].currentSize);
-
-    /* release FIFO semaphore */
-    //G8RTOS_SignalSemaphore(&FIFOs[FIFOChoice].mutex);
 
     /* return error code */
     return 1;
 }
+
+#endif /* G8RTOS_USE_IPC */
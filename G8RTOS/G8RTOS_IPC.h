@@ -10,12 +10,131 @@
 #ifndef G8RTOS_G8RTOS_IPC_H_
 #define G8RTOS_G8RTOS_IPC_H_
 
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include "G8RTOS_Config.h"
+#include "G8RTOS_Semaphores.h"
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                        DEFINES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* words of storage needed by a FIFO */
+#define FIFO_STORAGE_WORDS(elementSize, depth) (((elementSize) * (depth) + 3) / 4)
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                  DATA TYPE DEFINITIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * FIFO overflow policy
+ * What a write does when the FIFO is full
+ *  - FIFO_DROP_NEWEST: discards the new element
+ *  - FIFO_OVERWRITE_OLDEST: replaces the oldest element
+ *  - FIFO_BLOCK: waits up to the FIFO timeout for space
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef enum
+{
+    FIFO_DROP_NEWEST = 0,
+    FIFO_OVERWRITE_OLDEST = 1,
+    FIFO_BLOCK = 2
+} fifoPolicy_t;
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * FIFO typedef
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef struct fifo fifo_t;
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * FIFO
+ * A FIFO of depth elements of elementSize bytes over
+ * static storage. count is the number of stored
+ * elements, currentSize the elements not yet claimed by
+ * a reader and spaces the free slots not yet claimed by
+ * a FIFO_BLOCK writer. lostData counts dropped and
+ * overwritten elements
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+struct fifo {
+    uint8_t *buffer;
+    uint32_t elementSize;
+    uint32_t depth;
+    uint32_t head;
+    uint32_t count;
+    fifoPolicy_t policy;
+    uint32_t timeoutMS;
+    uint32_t lostData;
+    semaphore_t currentSize;
+    semaphore_t spaces;
+};
+
 /*
  * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
  *                    PUBLIC FUNCTIONS
  * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
  */
 
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_CreateFIFO
+ * INPUTS: (fifo_t *) fifo, (uint32_t *) storage,
+ *         (uint32_t) elementSize, (uint32_t) depth,
+ *         (fifoPolicy_t) policy, (uint32_t) timeoutMS
+ * OUTPUTS: (int) error
+ * Initializes an empty FIFO over static storage
+ *  - storage must hold FIFO_STORAGE_WORDS(elementSize,
+ *    depth) words
+ *  - timeoutMS is only used by FIFO_BLOCK writers
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_CreateFIFO(fifo_t *fifo, uint32_t *storage, uint32_t elementSize,
+                      uint32_t depth, fifoPolicy_t policy, uint32_t timeoutMS);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * readFIFOMany
+ * INPUTS: (fifo_t *) fifo, (void *) data,
+ *         (uint32_t) count, (uint32_t) timeoutMS
+ * OUTPUTS: (uint32_t) elements read
+ * Reads up to count elements into data
+ * - Waits at most timeoutMS for the first element, then
+ *   takes every other available element up to count
+ * - All elements are copied in one critical section
+ * - A timeout of 0 never blocks and is safe from ISRs
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t readFIFOMany(fifo_t *fifo, void *data, uint32_t count, uint32_t timeoutMS);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * writeFIFOMany
+ * INPUTS: (fifo_t *) fifo, (const void *) data,
+ *         (uint32_t) count
+ * OUTPUTS: (uint32_t) elements written
+ * Writes count elements from data
+ * - Full FIFOs follow the FIFO overflow policy
+ * - FIFO_BLOCK writes free slots in one critical section
+ *   each time space frees up, other policies write all
+ *   elements in one critical section
+ * - Safe from ISRs unless the policy is FIFO_BLOCK
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t writeFIFOMany(fifo_t *fifo, const void *data, uint32_t count);
+
 /*
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  * G8RTOS_InitFIFO
@@ -40,6 +159,30 @@ int G8RTOS_InitFIFO(uint32_t FIFOIndex);
  */
 uint32_t readFIFO(uint32_t FIFO);
 
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * tryReadFIFO
+ * INPUTS: (uint32_t) FIFOChoice, (uint32_t *) data
+ * OUTPUTS: (int) error
+ * Reads FIFO without blocking
+ * - Returns -1 immediately if the FIFO is empty
+ * - Otherwise stores data from head, increments the
+ *   head ptr (wraps if necessary) and returns 1
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int tryReadFIFO(uint32_t FIFO, uint32_t *data);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * FIFOSemaphore
+ * INPUTS: (uint32_t) FIFOChoice
+ * OUTPUTS: (semaphore_t *) currentSize
+ * Gets the semaphore counting the elements of FIFO, to
+ * wait for it with G8RTOS_Select
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+semaphore_t *FIFOSemaphore(uint32_t FIFO);
+
 /*
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  * writeFIFO
@@ -0,0 +1,133 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/11/2020                                                |
+ * | SUMMARY: G8RTOS_Mailbox.c                                       |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "G8RTOS_Mailbox.h"
+#include "G8RTOS_CriticalSection.h"
+#include "G8RTOS_Config.h"
+
+#if G8RTOS_USE_IPC
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_InitMailbox
+ * INPUTS: (mailbox_t *) mailbox, (void **) slots,
+ *         (uint32_t) depth
+ * OUTPUTS: (int) error
+ * Initializes an empty mailbox over depth static slots
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_InitMailbox(mailbox_t *mailbox, void **slots, uint32_t depth)
+{
+    /* return error code if mailbox has no slots */
+    if (depth == 0)
+        return -1;
+
+    /* assign default values to mailbox properties */
+    mailbox->slots = slots;
+    mailbox->depth = depth;
+    mailbox->head = 0;
+    mailbox->tail = 0;
+
+    /* mailbox starts empty */
+    G8RTOS_InitSemaphore(&mailbox->messages, 0);
+    G8RTOS_InitSemaphore(&mailbox->spaces, depth);
+
+    /* return error code */
+    return 1;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_MailboxSend
+ * INPUTS: (mailbox_t *) mailbox, (void *) message,
+ *         (uint32_t) timeoutMS
+ * OUTPUTS: (int) error
+ * Queues a message, waiting at most timeoutMS for a
+ * free slot
+ *  - On success the mailbox owns message, the sender
+ *    must not touch it anymore
+ *  - Returns -1 on timeout, the sender still owns message
+ *  - A timeout of 0 never blocks and is safe from ISRs
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_MailboxSend(mailbox_t *mailbox, void *message, uint32_t timeoutMS)
+{
+    /* wait for an empty slot */
+    if (!G8RTOS_WaitSemaphoreTimeout(&mailbox->spaces, timeoutMS))
+        return -1;
+
+    /* start critical section & disable interrupts */
+    int32_t status = StartCriticalSection();
+
+    /* write message to tail (wrap if necessary) */
+    mailbox->slots[mailbox->tail] = message;
+    if (++mailbox->tail == mailbox->depth)
+        mailbox->tail = 0;
+
+    /* wake up a receiver */
+    G8RTOS_SignalSemaphore(&mailbox->messages);
+
+    /* end critical section and enable interrupts */
+    EndCriticalSection(status);
+
+    /* return error code */
+    return 1;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_MailboxReceive
+ * INPUTS: (mailbox_t *) mailbox, (uint32_t) timeoutMS
+ * OUTPUTS: (void *) message
+ * Dequeues the oldest message, waiting at most timeoutMS
+ * for one to arrive
+ *  - The receiver owns the returned message
+ *  - Returns 0 on timeout
+ *  - A timeout of 0 never blocks and is safe from ISRs
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void *G8RTOS_MailboxReceive(mailbox_t *mailbox, uint32_t timeoutMS)
+{
+    /* wait for a message */
+    if (!G8RTOS_WaitSemaphoreTimeout(&mailbox->messages, timeoutMS))
+        return 0;
+
+    /* start critical section & disable interrupts */
+    int32_t status = StartCriticalSection();
+
+    /* read message from head (wrap if necessary) */
+    void *message = mailbox->slots[mailbox->head];
+    if (++mailbox->head == mailbox->depth)
+        mailbox->head = 0;
+
+    /* wake up a sender */
+    G8RTOS_SignalSemaphore(&mailbox->spaces);
+
+    /* end critical section and enable interrupts */
+    EndCriticalSection(status);
+
+    return message;
+}
+
+#endif /* G8RTOS_USE_IPC */
@@ -0,0 +1,103 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/11/2020                                                |
+ * | SUMMARY: G8RTOS_Mailbox.h                                       |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifndef G8RTOS_MAILBOX_H_
+#define G8RTOS_MAILBOX_H_
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "G8RTOS_Semaphores.h"
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                  DATA TYPE DEFINITIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Mailbox typedef
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef struct mailbox mailbox_t;
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Mailbox
+ * A mailbox queues pointers to messages, usually blocks
+ * of a pool_t. Sending a message hands its ownership
+ * to the mailbox and receiving one hands it to the
+ * receiver, which must free it. messages counts queued
+ * pointers and spaces counts empty slots
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+struct mailbox {
+    void **slots;
+    uint32_t depth;
+    uint32_t head;
+    uint32_t tail;
+    semaphore_t messages;
+    semaphore_t spaces;
+};
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_InitMailbox
+ * INPUTS: (mailbox_t *) mailbox, (void **) slots,
+ *         (uint32_t) depth
+ * OUTPUTS: (int) error
+ * Initializes an empty mailbox over depth static slots
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_InitMailbox(mailbox_t *mailbox, void **slots, uint32_t depth);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_MailboxSend
+ * INPUTS: (mailbox_t *) mailbox, (void *) message,
+ *         (uint32_t) timeoutMS
+ * OUTPUTS: (int) error
+ * Queues a message, waiting at most timeoutMS for a
+ * free slot
+ *  - On success the mailbox owns message, the sender
+ *    must not touch it anymore
+ *  - Returns -1 on timeout, the sender still owns message
+ *  - A timeout of 0 never blocks and is safe from ISRs
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_MailboxSend(mailbox_t *mailbox, void *message, uint32_t timeoutMS);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_MailboxReceive
+ * INPUTS: (mailbox_t *) mailbox, (uint32_t) timeoutMS
+ * OUTPUTS: (void *) message
+ * Dequeues the oldest message, waiting at most timeoutMS
+ * for one to arrive
+ *  - The receiver owns the returned message
+ *  - Returns 0 on timeout
+ *  - A timeout of 0 never blocks and is safe from ISRs
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void *G8RTOS_MailboxReceive(mailbox_t *mailbox, uint32_t timeoutMS);
+
+#endif /* G8RTOS_MAILBOX_H_ */
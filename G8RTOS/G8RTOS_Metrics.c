@@ -0,0 +1,263 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/22/2020                                                |
+ * | SUMMARY: G8RTOS_Metrics.c                                       |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#include "G8RTOS_Config.h"
+
+#if G8RTOS_USE_METRICS
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include "BackChannelUart.h"
+#include "G8RTOS_Metrics.h"
+#include "G8RTOS_Scheduler.h"
+#include "G8RTOS_CriticalSection.h"
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PRIVATE VARIABLES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* registered metrics, oldest first */
+static metric_t *FirstMetric;
+static metric_t *LastMetric;
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                   PRIVATE FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Append
+ * INPUTS: (char *) buffer, (uint32_t) size,
+ *         (uint32_t *) length, (const char *) format
+ * OUTPUTS: (bool) fits
+ * Prints format at buffer + *length and moves *length
+ * past it
+ *  - Returns false once the record does not fit
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static bool Append(char *buffer, uint32_t size, uint32_t *length, const char *format, ...)
+{
+    va_list args;
+
+    if (*length >= size)
+        return false;
+
+    va_start(args, format);
+    int32_t written = vsnprintf(buffer + *length, size - *length, format, args);
+    va_end(args);
+
+    if (written < 0 || (uint32_t)written >= size - *length)
+        return false;
+
+    *length += written;
+    return true;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * AppendList
+ * INPUTS: (char *) buffer, (uint32_t) size,
+ *         (uint32_t *) length,
+ *         (const volatile uint32_t *) values,
+ *         (uint32_t) count
+ * OUTPUTS: (bool) fits
+ * Appends values as a JSON array
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static bool AppendList(char *buffer, uint32_t size, uint32_t *length,
+                       const volatile uint32_t *values, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (!Append(buffer, size, length, i ? ",%lu" : "[%lu", (unsigned long)values[i]))
+            return false;
+    }
+
+    return Append(buffer, size, length, "]");
+}
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_RegisterMetric
+ * INPUTS: (metric_t *) metric
+ * OUTPUTS: void
+ * Links a metric into the registry so snapshots include
+ * it, updates before this are kept
+ *  - Registering a metric again does nothing, modules
+ *    can register from their init functions
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_RegisterMetric(metric_t *metric)
+{
+    int32_t status = StartCriticalSection();
+
+    if (!metric->registered)
+    {
+        /* linked at the tail with next already 0, a snapshot walking the list never sees it half added */
+        metric->registered = true;
+        metric->next = 0;
+
+        if (LastMetric)
+            LastMetric->next = metric;
+        else
+            FirstMetric = metric;
+
+        LastMetric = metric;
+    }
+
+    EndCriticalSection(status);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_MetricAdd
+ * INPUTS: (metric_t *) metric, (uint32_t) count
+ * OUTPUTS: void
+ * Adds count to a counter, or to a gauge
+ *  - Lock free, safe from interrupts
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_MetricAdd(metric_t *metric, uint32_t count)
+{
+    AtomicAdd(&metric->value, count);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_MetricSet
+ * INPUTS: (metric_t *) metric, (int32_t) value
+ * OUTPUTS: void
+ * Sets a gauge
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_MetricSet(metric_t *metric, int32_t value)
+{
+    metric->value = (uint32_t)value;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_MetricObserve
+ * INPUTS: (metric_t *) metric, (uint32_t) sample
+ * OUTPUTS: void
+ * Counts sample in the first bucket whose bound is not
+ * below it and adds it to the histogram's sum
+ *  - Lock free, safe from interrupts
+ *  - A snapshot taken in between may see the bucket
+ *    without the sum
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_MetricObserve(metric_t *metric, uint32_t sample)
+{
+    uint32_t bucket = 0;
+
+    while (bucket < metric->numberOfBuckets - 1 && sample > metric->bounds[bucket])
+        bucket++;
+
+    AtomicAdd(&metric->buckets[bucket], 1);
+    AtomicAdd(&metric->value, sample);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_MetricsSnapshot
+ * INPUTS: (char *) buffer, (uint32_t) size
+ * OUTPUTS: (uint32_t) length
+ * Writes every registered metric as one JSON object,
+ * in the order they were registered:
+ *   {"t":ms,"counter":n,"gauge":-n,
+ *    "histogram":{"sum":n,"le":[bounds],"b":[buckets]}}
+ *  - Returns the length without the terminating 0, or
+ *    0 if the record does not fit in size
+ *  - Metrics are read one at a time, not all at once
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_MetricsSnapshot(char *buffer, uint32_t size)
+{
+    uint32_t length = 0;
+    bool fits = Append(buffer, size, &length, "{\"t\":%lu", (unsigned long)SystemTime);
+
+    for (metric_t *metric = FirstMetric; metric && fits; metric = metric->next)
+    {
+        uint32_t value = metric->value;
+
+        switch (metric->type)
+        {
+        case METRIC_COUNTER:
+            fits = Append(buffer, size, &length, ",\"%s\":%lu", metric->name, (unsigned long)value);
+            break;
+        case METRIC_GAUGE:
+            fits = Append(buffer, size, &length, ",\"%s\":%ld", metric->name, (long)(int32_t)value);
+            break;
+        case METRIC_HISTOGRAM:
+            fits = Append(buffer, size, &length, ",\"%s\":{\"sum\":%lu,\"le\":", metric->name, (unsigned long)value)
+                && AppendList(buffer, size, &length, metric->bounds, metric->numberOfBuckets - 1)
+                && Append(buffer, size, &length, ",\"b\":")
+                && AppendList(buffer, size, &length, metric->buckets, metric->numberOfBuckets)
+                && Append(buffer, size, &length, "}");
+            break;
+        }
+    }
+
+    if (!fits || !Append(buffer, size, &length, "}"))
+    {
+        if (size)
+            buffer[0] = 0;
+        return 0;
+    }
+
+    return length;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_MetricsWrite
+ * INPUTS: (char *) buffer, (uint32_t) size
+ * OUTPUTS: (uint32_t) length
+ * Takes a snapshot into buffer and writes it to the
+ * back channel UART as one line
+ *  - Returns the snapshot's length, so the same record
+ *    can also be sent as a telemetry packet
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_MetricsWrite(char *buffer, uint32_t size)
+{
+    uint32_t length = G8RTOS_MetricsSnapshot(buffer, size);
+
+    if (length)
+    {
+        BackChannelWrite(buffer);
+        BackChannelWrite("\r\n");
+    }
+    else
+    {
+        BackChannelWrite("# metrics: record does not fit the buffer\r\n");
+    }
+
+    return length;
+}
+
+#endif /* G8RTOS_USE_METRICS */
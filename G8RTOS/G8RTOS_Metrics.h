@@ -0,0 +1,204 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/22/2020                                                |
+ * | SUMMARY: G8RTOS_Metrics.h                                       |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifndef G8RTOS_METRICS_H_
+#define G8RTOS_METRICS_H_
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "G8RTOS_Config.h"
+
+/*
+ * The metrics registry is one place to read the counters
+ * kept by the kernel, LCD, network and sensor code.
+ * Every metric is a static variable defined with one of
+ * the macros below and linked into the registry by
+ * G8RTOS_RegisterMetric, nothing is allocated. Updates
+ * are single atomic adds or stores, safe from threads
+ * and interrupts without a critical section
+ */
+
+#if G8RTOS_USE_METRICS
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                  DATA TYPE DEFINITIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Metric Type
+ *  - METRIC_COUNTER only grows
+ *  - METRIC_GAUGE holds the last value set, signed
+ *  - METRIC_HISTOGRAM counts samples in fixed buckets
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef enum metricType {
+    METRIC_COUNTER,
+    METRIC_GAUGE,
+    METRIC_HISTOGRAM
+} metricType_t;
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Metric typedef
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef struct metric metric_t;
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Metric
+ * One named value in the registry
+ *  - value is the counter or gauge, for a histogram the
+ *    sum of its samples
+ *  - bucket i of a histogram counts samples up to
+ *    bounds[i], the last bucket the samples above every
+ *    bound
+ *  - next links the registered metrics
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+struct metric {
+    const char *name;
+    metricType_t type;
+    volatile uint32_t value;
+    const uint32_t *bounds;
+    volatile uint32_t *buckets;
+    uint32_t numberOfBuckets;
+    bool registered;
+    metric_t *next;
+};
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                   DEFINITION MACROS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* defines a static counter named name, register it before the first snapshot */
+#define G8RTOS_COUNTER(var, name) \
+    static metric_t var = { name, METRIC_COUNTER, 0, 0, 0, 0, false, 0 }
+
+/* defines a static gauge named name */
+#define G8RTOS_GAUGE(var, name) \
+    static metric_t var = { name, METRIC_GAUGE, 0, 0, 0, 0, false, 0 }
+
+/* defines a static histogram named name with the ascending bucket bounds that follow */
+#define G8RTOS_HISTOGRAM(var, name, ...) \
+    static const uint32_t var##Bounds[] = { __VA_ARGS__ }; \
+    static volatile uint32_t var##Buckets[sizeof(var##Bounds) / sizeof(uint32_t) + 1]; \
+    static metric_t var = { name, METRIC_HISTOGRAM, 0, var##Bounds, var##Buckets, \
+                            sizeof(var##Bounds) / sizeof(uint32_t) + 1, false, 0 }
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_RegisterMetric
+ * INPUTS: (metric_t *) metric
+ * OUTPUTS: void
+ * Links a metric into the registry so snapshots include
+ * it, updates before this are kept
+ *  - Registering a metric again does nothing, modules
+ *    can register from their init functions
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_RegisterMetric(metric_t *metric);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_MetricAdd
+ * INPUTS: (metric_t *) metric, (uint32_t) count
+ * OUTPUTS: void
+ * Adds count to a counter, or to a gauge
+ *  - Lock free, safe from interrupts
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_MetricAdd(metric_t *metric, uint32_t count);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_MetricSet
+ * INPUTS: (metric_t *) metric, (int32_t) value
+ * OUTPUTS: void
+ * Sets a gauge
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_MetricSet(metric_t *metric, int32_t value);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_MetricObserve
+ * INPUTS: (metric_t *) metric, (uint32_t) sample
+ * OUTPUTS: void
+ * Counts sample in the first bucket whose bound is not
+ * below it and adds it to the histogram's sum
+ *  - Lock free, safe from interrupts
+ *  - A snapshot taken in between may see the bucket
+ *    without the sum
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_MetricObserve(metric_t *metric, uint32_t sample);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_MetricsSnapshot
+ * INPUTS: (char *) buffer, (uint32_t) size
+ * OUTPUTS: (uint32_t) length
+ * Writes every registered metric as one JSON object,
+ * in the order they were registered:
+ *   {"t":ms,"counter":n,"gauge":-n,
+ *    "histogram":{"sum":n,"le":[bounds],"b":[buckets]}}
+ *  - Returns the length without the terminating 0, or
+ *    0 if the record does not fit in size
+ *  - Metrics are read one at a time, not all at once
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_MetricsSnapshot(char *buffer, uint32_t size);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_MetricsWrite
+ * INPUTS: (char *) buffer, (uint32_t) size
+ * OUTPUTS: (uint32_t) length
+ * Takes a snapshot into buffer and writes it to the
+ * back channel UART as one line
+ *  - Returns the snapshot's length, so the same record
+ *    can also be sent as a telemetry packet
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_MetricsWrite(char *buffer, uint32_t size);
+
+#else
+
+/* a definition still has to leave a declaration behind, the caller's semicolon follows it */
+#define G8RTOS_COUNTER(var, name) extern int G8RTOS_metric_unused_
+#define G8RTOS_GAUGE(var, name) extern int G8RTOS_metric_unused_
+#define G8RTOS_HISTOGRAM(var, name, ...) extern int G8RTOS_metric_unused_
+#define G8RTOS_RegisterMetric(metric)
+#define G8RTOS_MetricAdd(metric, count) ((void)(count))
+#define G8RTOS_MetricSet(metric, value) ((void)(value))
+#define G8RTOS_MetricObserve(metric, sample) ((void)(sample))
+#define G8RTOS_MetricsSnapshot(buffer, size) 0
+#define G8RTOS_MetricsWrite(buffer, size) 0
+
+#endif /* G8RTOS_USE_METRICS */
+
+#endif /* G8RTOS_METRICS_H_ */
@@ -0,0 +1,219 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/06/2020                                                |
+ * | SUMMARY: G8RTOS_Pool.c                                          |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "G8RTOS_Pool.h"
+#include "G8RTOS_CriticalSection.h"
+#include "G8RTOS_Config.h"
+
+#if G8RTOS_USE_POOL
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PRIVATE FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * PopBlock
+ * INPUTS: (pool_t *) pool
+ * OUTPUTS: (void *) block
+ * Unlinks the first block of the free list
+ *  - The caller must already hold one count of the
+ *    available semaphore
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void *PopBlock(pool_t *pool)
+{
+    /* start critical section & disable interrupts */
+    int32_t status = StartCriticalSection();
+
+    /* unlink first free block */
+    void *block = pool->freeList;
+    pool->freeList = *(void **)block;
+    pool->numFree--;
+
+    /* track the most blocks ever in use */
+    if (pool->numBlocks - pool->numFree > pool->highWater)
+        pool->highWater = pool->numBlocks - pool->numFree;
+
+    /* end critical section and enable interrupts */
+    EndCriticalSection(status);
+
+    return block;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * CountFailure
+ * INPUTS: (pool_t *) pool
+ * OUTPUTS: (void *) 0
+ * Counts a failed allocation
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void *CountFailure(pool_t *pool)
+{
+    /* start critical section & disable interrupts */
+    int32_t status = StartCriticalSection();
+
+    pool->failures++;
+
+    /* end critical section and enable interrupts */
+    EndCriticalSection(status);
+
+    return 0;
+}
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_InitPool
+ * INPUTS: (pool_t *) pool, (uint32_t *) storage,
+ *         (uint32_t) blockSize, (uint32_t) numBlocks
+ * OUTPUTS: (int) error
+ * Initializes a pool over static storage
+ *  - storage must hold POOL_STORAGE_WORDS(blockSize,
+ *    numBlocks) words and be aligned for a pointer
+ *  - Links every block into the free list
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_InitPool(pool_t *pool, uint32_t *storage, uint32_t blockSize, uint32_t numBlocks)
+{
+    /* return error code if pool is empty or the next pointers would be misaligned */
+    if (blockSize == 0 || numBlocks == 0 || (uintptr_t)storage % sizeof(void *) != 0)
+        return -1;
+
+    /* round block size up to whole pointers, a free block holds the next pointer */
+    blockSize = POOL_BLOCK_SIZE(blockSize);
+
+    /* start critical section & disable interrupts */
+    int32_t status = StartCriticalSection();
+
+    /* link every block to the next one */
+    uint8_t *block = (uint8_t *)storage;
+    for (int i = 0; i < numBlocks - 1; i++) {
+        *(void **)block = block + blockSize;
+        block += blockSize;
+    }
+    *(void **)block = 0;
+
+    /* assign default values to pool properties */
+    pool->freeList = storage;
+    pool->start = (uint8_t *)storage;
+    pool->end = (uint8_t *)storage + blockSize * numBlocks;
+    pool->blockSize = blockSize;
+    pool->numBlocks = numBlocks;
+    pool->numFree = numBlocks;
+    pool->highWater = 0;
+    pool->failures = 0;
+
+    /* every block is available */
+    G8RTOS_InitSemaphore(&pool->available, numBlocks);
+
+    /* end critical section and enable interrupts */
+    EndCriticalSection(status);
+
+    /* return error code */
+    return 1;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PoolAlloc
+ * INPUTS: (pool_t *) pool
+ * OUTPUTS: (void *) block
+ * Allocates a block without blocking
+ *  - Returns 0 and counts a failure if the pool is empty
+ *  - Safe to call from ISRs
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void *G8RTOS_PoolAlloc(pool_t *pool)
+{
+    /* count failure if no block is available */
+    if (!G8RTOS_TryWaitSemaphore(&pool->available))
+        return CountFailure(pool);
+
+    return PopBlock(pool);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PoolAllocTimeout
+ * INPUTS: (pool_t *) pool, (uint32_t) timeoutMS
+ * OUTPUTS: (void *) block
+ * Allocates a block, waiting at most timeoutMS for one
+ * to be freed
+ *  - Returns 0 and counts a failure on timeout
+ *  - Threads only, never call from an ISR
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void *G8RTOS_PoolAllocTimeout(pool_t *pool, uint32_t timeoutMS)
+{
+    /* count failure if no block was freed in time */
+    if (!G8RTOS_WaitSemaphoreTimeout(&pool->available, timeoutMS))
+        return CountFailure(pool);
+
+    return PopBlock(pool);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PoolFree
+ * INPUTS: (pool_t *) pool, (void *) block
+ * OUTPUTS: (int) error
+ * Returns a block to the pool
+ *  - Returns -1 if block does not belong to the pool
+ *  - Wakes a thread waiting for a block
+ *  - Safe to call from ISRs
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_PoolFree(pool_t *pool, void *block)
+{
+    /* return error code if block is outside of the pool or misaligned */
+    if ((uint8_t *)block < pool->start || (uint8_t *)block >= pool->end ||
+        ((uint8_t *)block - pool->start) % pool->blockSize != 0)
+        return -1;
+
+    /* start critical section & disable interrupts */
+    int32_t status = StartCriticalSection();
+
+    /* link block in front of the free list */
+    *(void **)block = pool->freeList;
+    pool->freeList = block;
+    pool->numFree++;
+
+    /* make block available, waking a waiting thread */
+    G8RTOS_SignalSemaphore(&pool->available);
+
+    /* end critical section and enable interrupts */
+    EndCriticalSection(status);
+
+    /* return error code */
+    return 1;
+}
+
+#endif /* G8RTOS_USE_POOL */
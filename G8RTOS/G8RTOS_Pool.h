@@ -0,0 +1,131 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/06/2020                                                |
+ * | SUMMARY: G8RTOS_Pool.h                                          |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifndef G8RTOS_POOL_H_
+#define G8RTOS_POOL_H_
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "G8RTOS_Semaphores.h"
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                        DEFINES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* size of a pool block, rounded up to whole pointers so a free block holds an aligned next pointer */
+#define POOL_BLOCK_SIZE(blockSize) ((((blockSize) + sizeof(void *) - 1) / sizeof(void *)) * sizeof(void *))
+
+/* words of storage needed by a pool */
+#define POOL_STORAGE_WORDS(blockSize, numBlocks) (POOL_BLOCK_SIZE(blockSize) / 4 * (numBlocks))
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                  DATA TYPE DEFINITIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Pool typedef
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef struct pool pool_t;
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Pool
+ * A pool hands out fixed-size blocks carved from static
+ * storage. Free blocks are linked through their first
+ * word, so the pool needs no memory besides the blocks.
+ * The available semaphore counts free blocks so that
+ * threads can block until one is freed
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+struct pool {
+    void *freeList;
+    uint8_t *start;
+    uint8_t *end;
+    uint32_t blockSize;
+    uint32_t numBlocks;
+    uint32_t numFree;
+    uint32_t highWater;
+    uint32_t failures;
+    semaphore_t available;
+};
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_InitPool
+ * INPUTS: (pool_t *) pool, (uint32_t *) storage,
+ *         (uint32_t) blockSize, (uint32_t) numBlocks
+ * OUTPUTS: (int) error
+ * Initializes a pool over static storage
+ *  - storage must hold POOL_STORAGE_WORDS(blockSize,
+ *    numBlocks) words and be aligned for a pointer
+ *  - Links every block into the free list
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_InitPool(pool_t *pool, uint32_t *storage, uint32_t blockSize, uint32_t numBlocks);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PoolAlloc
+ * INPUTS: (pool_t *) pool
+ * OUTPUTS: (void *) block
+ * Allocates a block without blocking
+ *  - Returns 0 and counts a failure if the pool is empty
+ *  - Safe to call from ISRs
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void *G8RTOS_PoolAlloc(pool_t *pool);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PoolAllocTimeout
+ * INPUTS: (pool_t *) pool, (uint32_t) timeoutMS
+ * OUTPUTS: (void *) block
+ * Allocates a block, waiting at most timeoutMS for one
+ * to be freed
+ *  - Returns 0 and counts a failure on timeout
+ *  - Threads only, never call from an ISR
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void *G8RTOS_PoolAllocTimeout(pool_t *pool, uint32_t timeoutMS);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PoolFree
+ * INPUTS: (pool_t *) pool, (void *) block
+ * OUTPUTS: (int) error
+ * Returns a block to the pool
+ *  - Returns -1 if block does not belong to the pool
+ *  - Wakes a thread waiting for a block
+ *  - Safe to call from ISRs
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_PoolFree(pool_t *pool, void *block);
+
+#endif /* G8RTOS_POOL_H_ */
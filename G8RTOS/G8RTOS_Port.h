@@ -0,0 +1,198 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/18/2020                                                |
+ * | SUMMARY: G8RTOS_Port.h                                          |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifndef G8RTOS_PORT_H_
+#define G8RTOS_PORT_H_
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "G8RTOS_Config.h"
+
+/*
+ * The port holds everything the kernel needs from the
+ * target: the tick, stack frames, context switches and
+ * interrupt vectors. G8RTOS_PortMSP432.c runs on the
+ * board, G8RTOS_PortPOSIX.c runs on a Linux host when
+ * G8RTOS_PORT_POSIX is defined (see host/Makefile)
+ */
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                        DEFINES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#ifndef G8RTOS_PORT_POSIX
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortYield
+ * Requests a context switch by setting the PendSV flag
+ *  - The switch happens once interrupts are enabled
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+#define G8RTOS_PortYield() (SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk)
+#endif
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortInit
+ * INPUTS: void
+ * OUTPUTS: void
+ * Initializes the board and relocates the interrupt
+ * vectors so aperiodic events can be installed
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortInit();
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortStartTick
+ * INPUTS: void
+ * OUTPUTS: void
+ * Starts the 1 ms tick that calls SysTick_Handler
+ *  - The tick and context switches run at
+ *    OSINT_PRIORITY
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortStartTick();
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortInitStack
+ * INPUTS: (uint32_t) index, (int32_t *) stack,
+ *         (void)(* thread)(void)
+ * OUTPUTS: (int32_t *) stackPointer
+ * Builds the initial context of thread index so the
+ * first switch to it starts thread
+ *  - stack holds STACKSIZE words
+ *  - The returned value is stored in the tcb and only
+ *    read back by the port's context switch
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int32_t *G8RTOS_PortInitStack(uint32_t index, int32_t *stack, void (*thread)(void));
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortStart
+ * INPUTS: void
+ * OUTPUTS: void
+ * Switches to CurrentlyRunningThread with interrupts
+ * enabled
+ *  - Only returns if starting the thread failed
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortStart();
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortEnableIRQ
+ * INPUTS: (IRQn_Type) IRQn, (void)(* handler)(void),
+ *         (uint8_t) priority
+ * OUTPUTS: void
+ * Installs handler as the vector of IRQn and enables
+ * the interrupt at priority
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortEnableIRQ(IRQn_Type IRQn, void (*handler)(void), uint8_t priority);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortInitCycles
+ * INPUTS: void
+ * OUTPUTS: void
+ * Starts the free running cycle counter read by
+ * G8RTOS_PortCycles
+ *  - Does nothing if it already runs, every user may
+ *    call it and only differences are meaningful
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortInitCycles();
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortCycles
+ * INPUTS: void
+ * OUTPUTS: (uint32_t) cycles
+ * Reads the cycle counter, differences are wrap safe
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_PortCycles();
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortCyclesPerMS
+ * INPUTS: void
+ * OUTPUTS: (uint32_t) cycles
+ * Cycle counter ticks in one ms of SystemTime
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_PortCyclesPerMS();
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortStartSampler
+ * INPUTS: (uint32_t) rateHz
+ * OUTPUTS: void
+ * Starts a timer interrupt that passes the interrupted
+ * PC to G8RTOS_ProfilerSample rateHz times a second
+ *  - Runs at PROFILER_IRQ_PRIORITY, samples due inside
+ *    a critical section land where it ends
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortStartSampler(uint32_t rateHz);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortStopSampler
+ * INPUTS: void
+ * OUTPUTS: void
+ * Stops the timer started by G8RTOS_PortStartSampler
+ *  - Safe to call from G8RTOS_ProfilerSample
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortStopSampler();
+
+#ifdef G8RTOS_PORT_POSIX
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortYield
+ * INPUTS: void
+ * OUTPUTS: void
+ * Switches to the thread picked by G8RTOS_Scheduler
+ *  - Inside a critical section the switch waits until
+ *    the outermost EndCriticalSection, like PendSV
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortYield();
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortRaiseIRQ
+ * INPUTS: (IRQn_Type) IRQn
+ * OUTPUTS: void
+ * Runs the handler installed for IRQn as an interrupt
+ * would, so host code can simulate peripherals
+ *  - Does nothing if IRQn has no handler
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortRaiseIRQ(IRQn_Type IRQn);
+#endif
+
+#endif /* G8RTOS_PORT_H_ */
@@ -0,0 +1,324 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/18/2020                                                |
+ * | SUMMARY: G8RTOS_PortMSP432.c                                    |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifndef G8RTOS_PORT_POSIX
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <BSP.h>
+#include <driverlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "msp.h"
+#include "G8RTOS_Port.h"
+#include "G8RTOS_Boot.h"
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_Start
+ * INPUTS: void
+ * OUTPUTS: void
+ * ASM function to start the G8RTOS
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+extern void G8RTOS_Start();
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_ProfilerISR
+ * INPUTS: void
+ * OUTPUTS: void
+ * ASM Timer_A3 handler, reads the stacked PC and tail
+ * calls G8RTOS_PortSamplerHandler with it
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+extern void G8RTOS_ProfilerISR();
+
+/* records one sample, G8RTOS_Profiler.c */
+extern void G8RTOS_ProfilerSample(uintptr_t pc);
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                        DEFINES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* Status Register with the Thumb-bit Set */
+#define THUMBBIT 0x01000000
+
+/* desired overflow time for SysTick */
+#define SysTickHigh 0.001f
+
+/* largest Timer_A period */
+#define TIMER_A_MAX_PERIOD 0xFFFF
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PRIVATE FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * InitSysTick
+ * INPUTS: (uint32_t) numCycles
+ * OUTPUTS: void
+ * Initializes the Systick and Systick Interrupt
+ *  - The Systick interrupt will be responsible for
+ *    starting a context switch between threads
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void InitSysTick(uint32_t numCycles)
+{
+    /* configure SysTick */
+    SysTick_Config(numCycles - 1);
+
+    /* enable SysTick interrupts */
+    SysTick_enableInterrupt();
+}
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortInit
+ * INPUTS: void
+ * OUTPUTS: void
+ * Initializes the board and relocates the interrupt
+ * vectors so aperiodic events can be installed
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortInit()
+{
+    /* init all hardware on board */
+    G8RTOS_BootBegin("BSP_InitBoard");
+    BSP_InitBoard();
+    G8RTOS_BootEnd();
+
+    /* relocate ISRs interrupt vectors to SRAM */
+    uint32_t newVTORTable = 0x20000000;
+    memcpy((uint32_t *)newVTORTable, (uint32_t *)SCB->VTOR, 57*4);
+    SCB->VTOR = newVTORTable;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortStartTick
+ * INPUTS: void
+ * OUTPUTS: void
+ * Starts the 1 ms tick that calls SysTick_Handler
+ *  - The tick and context switches run at
+ *    OSINT_PRIORITY
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortStartTick()
+{
+    /* set SysTick to lowest priority */
+    NVIC_SetPriority(SysTick_IRQn, OSINT_PRIORITY);
+
+    /* set PendSV to lowest priority */
+    NVIC_SetPriority(PendSV_IRQn, OSINT_PRIORITY);
+
+    /* set SysTick interrupt every 1 ms */
+    InitSysTick(ClockSys_GetSysFreq() * SysTickHigh);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortInitStack
+ * INPUTS: (uint32_t) index, (int32_t *) stack,
+ *         (void)(* thread)(void)
+ * OUTPUTS: (int32_t *) stackPointer
+ * Builds the initial context of thread index so the
+ * first switch to it starts thread
+ *  - stack holds STACKSIZE words
+ *  - The returned value is stored in the tcb and only
+ *    read back by the port's context switch
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int32_t *G8RTOS_PortInitStack(uint32_t index, int32_t *stack, void (*thread)(void))
+{
+    /* store context */
+    stack[STACKSIZE - 1] = THUMBBIT;                // PSR w/ thumbit enabled
+    stack[STACKSIZE - 2] = (int32_t)(thread);       // PC w/ functiooon pointer to thread
+    stack[STACKSIZE - 3] = 0x14141414;              // LR w/ dummy data
+    stack[STACKSIZE - 4] = 0x12121212;              // r12 w/ dummy data
+    stack[STACKSIZE - 5] = 0x03030303;              // r3 w/ dummy data
+    stack[STACKSIZE - 6] = 0x02020202;              // r2 w/ dummy data
+    stack[STACKSIZE - 7] = 0x01010101;              // r1 w/ dummy data
+    stack[STACKSIZE - 8] = 0x00000000;              // r0 w/ dummy data
+    stack[STACKSIZE - 9] = 0x11111111;              // r11 w/ dummy data
+    stack[STACKSIZE - 10] = 0x10101010;             // r10 w/ dummy data
+    stack[STACKSIZE - 11] = 0x09090909;             // r9 w/ dummy data
+    stack[STACKSIZE - 12] = 0x08080808;             // r8 w/ dummy data
+    stack[STACKSIZE - 13] = 0x07070707;             // r7 w/ dummy data
+    stack[STACKSIZE - 14] = 0x06060606;             // r6 w/ dummy data
+    stack[STACKSIZE - 15] = 0x05050505;             // r5 w/ dummy data
+    stack[STACKSIZE - 16] = 0x04040404;             // r4 w/ dummy data
+
+    /* sp of thread */
+    return &stack[STACKSIZE - 16];
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortStart
+ * INPUTS: void
+ * OUTPUTS: void
+ * Switches to CurrentlyRunningThread with interrupts
+ * enabled
+ *  - Only returns if starting the thread failed
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortStart()
+{
+    /* set context of first thread */
+    G8RTOS_Start();
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortEnableIRQ
+ * INPUTS: (IRQn_Type) IRQn, (void)(* handler)(void),
+ *         (uint8_t) priority
+ * OUTPUTS: void
+ * Installs handler as the vector of IRQn and enables
+ * the interrupt at priority
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortEnableIRQ(IRQn_Type IRQn, void (*handler)(void), uint8_t priority)
+{
+    /* initialize NVIC registers */
+    __NVIC_SetVector(IRQn, (uint32_t)handler);
+    __NVIC_SetPriority(IRQn, priority);
+    NVIC_EnableIRQ(IRQn);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortInitCycles
+ * INPUTS: void
+ * OUTPUTS: void
+ * Starts the free running cycle counter read by
+ * G8RTOS_PortCycles
+ *  - Does nothing if it already runs, every user may
+ *    call it and only differences are meaningful
+ *  - Uses the DWT cycle counter
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortInitCycles()
+{
+    /* the boot profiler, bench, profiler and governor share CYCCNT, never reset a running one */
+    if (DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)
+        return;
+
+    /* enable trace, then reset and start CYCCNT */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortCycles
+ * INPUTS: void
+ * OUTPUTS: (uint32_t) cycles
+ * Reads the cycle counter, differences are wrap safe
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_PortCycles()
+{
+    return DWT->CYCCNT;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortCyclesPerMS
+ * INPUTS: void
+ * OUTPUTS: (uint32_t) cycles
+ * Cycle counter ticks in one ms of SystemTime
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_PortCyclesPerMS()
+{
+    return ClockSys_GetSysFreq() / 1000;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortStartSampler
+ * INPUTS: (uint32_t) rateHz
+ * OUTPUTS: void
+ * Starts a timer interrupt that passes the interrupted
+ * PC to G8RTOS_ProfilerSample rateHz times a second
+ *  - Uses Timer_A3 in up mode on SMCLK, rates below
+ *    SMCLK / 65536 are clamped
+ *  - Runs at PROFILER_IRQ_PRIORITY, samples due inside
+ *    a critical section land where it ends
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortStartSampler(uint32_t rateHz)
+{
+    uint32_t period = CS_getSMCLK() / (rateHz ? rateHz : 1);
+    if (period > TIMER_A_MAX_PERIOD) period = TIMER_A_MAX_PERIOD;
+
+    /* stop and clear timer, count SMCLK */
+    TIMER_A3->CTL = TIMER_A_CTL_TASSEL_2 | TIMER_A_CTL_MC__STOP | TIMER_A_CTL_CLR;
+    TIMER_A3->CCR[0] = period - 1;
+    TIMER_A3->CCTL[0] = TIMER_A_CCTLN_CCIE;
+
+    G8RTOS_PortEnableIRQ(TA3_0_IRQn, G8RTOS_ProfilerISR, PROFILER_IRQ_PRIORITY);
+
+    /* count up to CCR0 */
+    TIMER_A3->CTL |= TIMER_A_CTL_MC__UP;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortStopSampler
+ * INPUTS: void
+ * OUTPUTS: void
+ * Stops the timer started by G8RTOS_PortStartSampler
+ *  - Safe to call from G8RTOS_ProfilerSample
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortStopSampler()
+{
+    TIMER_A3->CTL &= ~TIMER_A_CTL_MC_MASK;
+    TIMER_A3->CCTL[0] &= ~(TIMER_A_CCTLN_CCIE | TIMER_A_CCTLN_CCIFG);
+    NVIC_ClearPendingIRQ(TA3_0_IRQn);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortSamplerHandler
+ * INPUTS: (uintptr_t) pc
+ * OUTPUTS: void
+ * Clears the Timer_A3 flag and records pc, called by
+ * G8RTOS_ProfilerISR
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortSamplerHandler(uintptr_t pc)
+{
+    TIMER_A3->CCTL[0] &= ~TIMER_A_CCTLN_CCIFG;
+
+#if G8RTOS_USE_PROFILER
+    G8RTOS_ProfilerSample(pc);
+#endif
+}
+
+#endif /* G8RTOS_PORT_POSIX */
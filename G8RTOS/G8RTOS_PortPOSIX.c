@@ -0,0 +1,554 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/18/2020                                                |
+ * | SUMMARY: G8RTOS_PortPOSIX.c                                     |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifdef G8RTOS_PORT_POSIX
+
+/*
+ * Runs G8RTOS as a single Linux process. Every thread
+ * gets a ucontext on its own host stack, a timer signal
+ * stands in for SysTick and blocking that signal stands
+ * in for disabling interrupts. Context switches happen
+ * from the signal handler or from G8RTOS_PortYield,
+ * always with the signal blocked, the same way PendSV
+ * runs with interrupts disabled
+ */
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* register names of ucontext_t, before any libc header */
+#define _GNU_SOURCE
+
+#include <BSP.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/time.h>
+#include <ucontext.h>
+#include "G8RTOS_Port.h"
+#include "G8RTOS_Boot.h"
+#include "G8RTOS_Structures.h"
+#include "G8RTOS_CriticalSection.h"
+
+/* picks CurrentlyRunningThread, G8RTOS_Scheduler.c */
+extern void G8RTOS_Scheduler();
+
+/* kernel tick, G8RTOS_Scheduler.c */
+extern void SysTick_Handler();
+
+/* records one sample, G8RTOS_Profiler.c */
+extern void G8RTOS_ProfilerSample(uintptr_t pc);
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                        DEFINES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* bytes of host stack per thread, libc needs far more than STACKSIZE words */
+#define HOST_STACK_SIZE (64 * 1024)
+
+/* host microseconds per SysTick */
+#ifndef G8RTOS_PORT_TICK_US
+#define G8RTOS_PORT_TICK_US 1000
+#endif
+
+/* interrupt vectors that can be raised */
+#define MAX_IRQS 64
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PRIVATE VARIABLES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* saved context of every thread, the tcb stackPointer points here */
+static ucontext_t Contexts[MAX_THREADS];
+
+/* host stacks the contexts run on */
+static uint8_t HostStacks[MAX_THREADS][HOST_STACK_SIZE];
+
+/* entry point of every thread */
+static void (*Entries[MAX_THREADS])(void);
+
+/* handlers installed by G8RTOS_PortEnableIRQ */
+static void (*Vectors[MAX_IRQS])(void);
+
+/* timer driving the tick, G8RTOS_REAL_TIME=1 follows wall time instead of CPU time */
+static int TickTimer;
+
+/* the tick signal */
+static int TickSignalNumber;
+static sigset_t TickSignal;
+
+/* SystemTime at which the process exits, G8RTOS_RUN_MS, 0 runs forever */
+static uint32_t RunMS;
+
+/* mirrors PRIMASK, set while the tick signal is blocked */
+static volatile bool InterruptsDisabled;
+
+/* a yield was requested while interrupts were disabled */
+static volatile bool SwitchPending;
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PRIVATE FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * ContextSwitch
+ * INPUTS: void
+ * OUTPUTS: void
+ * Saves the running thread, calls G8RTOS_Scheduler and
+ * resumes the thread it picked, like PendSV_Handler
+ *  - Called with the tick signal blocked
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void ContextSwitch()
+{
+    SwitchPending = false;
+
+    /* get new tcb */
+    ucontext_t *from = (ucontext_t *)CurrentlyRunningThread->stackPointer;
+    G8RTOS_Scheduler();
+    ucontext_t *to = (ucontext_t *)CurrentlyRunningThread->stackPointer;
+
+    /* returns once this thread is picked again */
+    if (from != to)
+        swapcontext(from, to);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * ThreadEntry
+ * INPUTS: (int) index
+ * OUTPUTS: void
+ * First code every thread runs, enables interrupts and
+ * calls the thread like G8RTOS_Start does
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void ThreadEntry(int index)
+{
+    /* enable interrupts */
+    InterruptsDisabled = false;
+    sigprocmask(SIG_UNBLOCK, &TickSignal, 0);
+
+    /* start thread */
+    Entries[index]();
+
+    /* threads never return on the board either */
+    fprintf(stderr, "G8RTOS: thread %d returned\n", index);
+    exit(1);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * TickHandler
+ * INPUTS: (int) signal
+ * OUTPUTS: void
+ * Timer signal handler standing in for SysTick and
+ * PendSV
+ *  - The kernel blocks the tick signal while it runs
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void TickHandler(int signal)
+{
+    (void)signal;
+
+    /* interrupts are disabled while the handler runs */
+    InterruptsDisabled = true;
+
+    SysTick_Handler();
+
+    /* stop the simulation after the requested time */
+    if (RunMS && SystemTime >= RunMS)
+        exit(0);
+
+    /* run the PendSV requested by the tick */
+    if (SwitchPending)
+        ContextSwitch();
+
+    /* the signal is unblocked once the handler returns */
+    InterruptsDisabled = false;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * SamplerHandler
+ * INPUTS: (int) signal, (siginfo_t *) info,
+ *         (void *) context
+ * OUTPUTS: void
+ * Profiling signal handler, records the PC the signal
+ * interrupted
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void SamplerHandler(int signal, siginfo_t *info, void *context)
+{
+    (void)signal;
+    (void)info;
+
+#if G8RTOS_USE_PROFILER
+    mcontext_t *machine = &((ucontext_t *)context)->uc_mcontext;
+
+#if defined(__x86_64__)
+    G8RTOS_ProfilerSample((uintptr_t)machine->gregs[REG_RIP]);
+#elif defined(__aarch64__)
+    G8RTOS_ProfilerSample((uintptr_t)machine->pc);
+#else
+    (void)machine;
+    G8RTOS_ProfilerSample(0);
+#endif
+#else
+    (void)context;
+#endif
+}
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * StartCriticalSection
+ * INPUTS: void
+ * OUTPUTS: (int32_t) IBit_State
+ * Starts a critical section
+ *  - Returns 1 if interrupts were already disabled
+ *  - Blocks the tick signal
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int32_t StartCriticalSection()
+{
+    int32_t IBit_State = InterruptsDisabled;
+
+    sigprocmask(SIG_BLOCK, &TickSignal, 0);
+    InterruptsDisabled = true;
+
+    return IBit_State;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * EndCriticalSection
+ * INPUTS: (int32_t) IBit_State
+ * OUTPUTS: void
+ * Ends a critical section
+ *  - Unblocks the tick signal if interrupts were enabled
+ *    when the critical section started
+ *  - Runs a yield requested inside the critical section
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void EndCriticalSection(int32_t IBit_State)
+{
+    if (IBit_State)
+        return;
+
+    InterruptsDisabled = false;
+    sigprocmask(SIG_UNBLOCK, &TickSignal, 0);
+
+    if (SwitchPending)
+        G8RTOS_PortYield();
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * AtomicAdd
+ * INPUTS: (volatile uint32_t *) address, (uint32_t) value
+ * OUTPUTS: (uint32_t) new value
+ * Adds value to the word at address without blocking
+ * the tick signal
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t AtomicAdd(volatile uint32_t *address, uint32_t value)
+{
+    return __atomic_add_fetch(address, value, __ATOMIC_SEQ_CST);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortYield
+ * INPUTS: void
+ * OUTPUTS: void
+ * Switches to the thread picked by G8RTOS_Scheduler
+ *  - Inside a critical section the switch waits until
+ *    the outermost EndCriticalSection, like PendSV
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortYield()
+{
+    /* pend the switch until interrupts are enabled */
+    if (InterruptsDisabled) {
+        SwitchPending = true;
+        return;
+    }
+
+    int32_t status = StartCriticalSection();
+    ContextSwitch();
+    EndCriticalSection(status);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortRaiseIRQ
+ * INPUTS: (IRQn_Type) IRQn
+ * OUTPUTS: void
+ * Runs the handler installed for IRQn as an interrupt
+ * would, so host code can simulate peripherals
+ *  - Does nothing if IRQn has no handler
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortRaiseIRQ(IRQn_Type IRQn)
+{
+    if (IRQn < 0 || IRQn >= MAX_IRQS || !Vectors[IRQn])
+        return;
+
+    /* handlers run with the tick held off, switches they request run afterwards */
+    int32_t status = StartCriticalSection();
+    Vectors[IRQn]();
+    EndCriticalSection(status);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortInit
+ * INPUTS: void
+ * OUTPUTS: void
+ * Reads the simulation settings, initializes the host
+ * board stubs and holds the tick signal off until
+ * G8RTOS_PortStart
+ *  - G8RTOS_RUN_MS exits after that much SystemTime
+ *  - G8RTOS_REAL_TIME=1 ticks on wall time, by default
+ *    the tick is a virtual clock of the process' CPU
+ *    time so host load does not skew SystemTime. Linux
+ *    accounts CPU time per kernel tick, so the virtual
+ *    clock runs slower than wall time
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortInit()
+{
+    const char *runMS = getenv("G8RTOS_RUN_MS");
+    const char *realTime = getenv("G8RTOS_REAL_TIME");
+
+    RunMS = runMS ? strtoul(runMS, 0, 10) : 0;
+
+    if (realTime && atoi(realTime)) {
+        TickTimer = ITIMER_REAL;
+        TickSignalNumber = SIGALRM;
+    } else {
+        TickTimer = ITIMER_VIRTUAL;
+        TickSignalNumber = SIGVTALRM;
+    }
+
+    sigemptyset(&TickSignal);
+    sigaddset(&TickSignal, TickSignalNumber);
+
+    /* interrupts stay disabled until the first thread starts */
+    StartCriticalSection();
+
+    /* init all stubbed hardware */
+    G8RTOS_BootBegin("BSP_InitBoard");
+    BSP_InitBoard();
+    G8RTOS_BootEnd();
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortStartTick
+ * INPUTS: void
+ * OUTPUTS: void
+ * Starts the timer signal that calls SysTick_Handler
+ * every G8RTOS_PORT_TICK_US
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortStartTick()
+{
+    struct sigaction action = { 0 };
+    action.sa_handler = TickHandler;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(TickSignalNumber, &action, 0);
+
+    struct itimerval period = { 0 };
+    period.it_interval.tv_usec = G8RTOS_PORT_TICK_US;
+    period.it_value.tv_usec = G8RTOS_PORT_TICK_US;
+    setitimer(TickTimer, &period, 0);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortInitStack
+ * INPUTS: (uint32_t) index, (int32_t *) stack,
+ *         (void)(* thread)(void)
+ * OUTPUTS: (int32_t *) stackPointer
+ * Builds a context that starts thread on the host stack
+ * of thread index
+ *  - stack is not used, the returned value points to
+ *    the context
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int32_t *G8RTOS_PortInitStack(uint32_t index, int32_t *stack, void (*thread)(void))
+{
+    (void)stack;
+
+    ucontext_t *context = &Contexts[index];
+    getcontext(context);
+    context->uc_stack.ss_sp = HostStacks[index];
+    context->uc_stack.ss_size = HOST_STACK_SIZE;
+    context->uc_link = 0;
+
+    /* threads start with interrupts disabled like after PendSV */
+    sigaddset(&context->uc_sigmask, TickSignalNumber);
+
+    Entries[index] = thread;
+    makecontext(context, (void (*)(void))ThreadEntry, 1, (int)index);
+
+    return (int32_t *)context;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortStart
+ * INPUTS: void
+ * OUTPUTS: void
+ * Switches to CurrentlyRunningThread
+ *  - Only returns if starting the thread failed
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortStart()
+{
+    /* disable interrupts, the first thread enables them */
+    StartCriticalSection();
+
+    setcontext((ucontext_t *)CurrentlyRunningThread->stackPointer);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortEnableIRQ
+ * INPUTS: (IRQn_Type) IRQn, (void)(* handler)(void),
+ *         (uint8_t) priority
+ * OUTPUTS: void
+ * Installs handler so G8RTOS_PortRaiseIRQ can run it
+ *  - Priorities are ignored, raised interrupts run
+ *    right away
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortEnableIRQ(IRQn_Type IRQn, void (*handler)(void), uint8_t priority)
+{
+    (void)priority;
+
+    if (IRQn >= 0 && IRQn < MAX_IRQS)
+        Vectors[IRQn] = handler;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortInitCycles
+ * INPUTS: void
+ * OUTPUTS: void
+ * Starts the free running cycle counter read by
+ * G8RTOS_PortCycles
+ *  - Does nothing if it already runs, every user may
+ *    call it and only differences are meaningful
+ *  - Counts ns of wall time, which only matches
+ *    SystemTime with G8RTOS_REAL_TIME set
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortInitCycles()
+{
+    /* CLOCK_MONOTONIC always runs */
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortCycles
+ * INPUTS: void
+ * OUTPUTS: (uint32_t) cycles
+ * Reads the cycle counter, differences are wrap safe
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_PortCycles()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000000u + now.tv_nsec);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortCyclesPerMS
+ * INPUTS: void
+ * OUTPUTS: (uint32_t) cycles
+ * Cycle counter ticks in one ms of SystemTime
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_PortCyclesPerMS()
+{
+    return 1000000;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortStartSampler
+ * INPUTS: (uint32_t) rateHz
+ * OUTPUTS: void
+ * Starts a timer signal that passes the interrupted PC
+ * to G8RTOS_ProfilerSample rateHz times a second
+ *  - Uses ITIMER_PROF, which Linux only fires on its
+ *    own tick, so high rates are coarser than asked.
+ *    With the virtual clock tick both timers expire
+ *    together and every sample lands in TickHandler,
+ *    profile with G8RTOS_REAL_TIME=1
+ *  - Samples are taken inside critical sections too
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortStartSampler(uint32_t rateHz)
+{
+    struct sigaction action = { 0 };
+    action.sa_sigaction = SamplerHandler;
+    action.sa_flags = SA_RESTART | SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGPROF, &action, 0);
+
+    uint32_t periodUS = 1000000 / (rateHz ? rateHz : 1);
+    if (!periodUS) periodUS = 1;
+
+    struct itimerval period = { 0 };
+    period.it_interval.tv_sec = periodUS / 1000000;
+    period.it_interval.tv_usec = periodUS % 1000000;
+    period.it_value = period.it_interval;
+    setitimer(ITIMER_PROF, &period, 0);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_PortStopSampler
+ * INPUTS: void
+ * OUTPUTS: void
+ * Stops the timer started by G8RTOS_PortStartSampler
+ *  - Safe to call from G8RTOS_ProfilerSample
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_PortStopSampler()
+{
+    struct itimerval stop = { 0 };
+    setitimer(ITIMER_PROF, &stop, 0);
+}
+
+#endif /* G8RTOS_PORT_POSIX */
@@ -0,0 +1,229 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/20/2020                                                |
+ * | SUMMARY: G8RTOS_Profiler.c                                      |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#include "G8RTOS_Config.h"
+
+#if G8RTOS_USE_PROFILER
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include "msp.h"
+#include "BackChannelUart.h"
+#include "G8RTOS_Structures.h"
+#include "G8RTOS_Port.h"
+#include "G8RTOS_CriticalSection.h"
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                        DEFINES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* length of one dump line */
+#define LINE_LENGTH 64
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                  DATA TYPE DEFINITIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Profile Sample
+ * PC the sampling interrupt returned to and the thread
+ * that was running
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef struct profileSample {
+    uintptr_t pc;
+    threadID_t threadID;
+} profileSample_t;
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Profile Thread
+ * Copy of a thread's id and name taken for a dump
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef struct profileThread {
+    threadID_t threadID;
+    char threadName[MAX_NAME_LENGTH];
+} profileThread_t;
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PRIVATE VARIABLES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* samples of the current window */
+static profileSample_t Samples[PROFILER_SAMPLES];
+static volatile uint32_t NumberOfSamples;
+
+/* rate of the current window */
+static uint32_t SampleRate;
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_ProfilerSample
+ * INPUTS: (uintptr_t) pc
+ * OUTPUTS: void
+ * Records pc and the running thread, called by the
+ * port's sampling interrupt
+ *  - Stops the sampler once the window is full
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_ProfilerSample(uintptr_t pc)
+{
+    uint32_t i = NumberOfSamples;
+    if (i >= PROFILER_SAMPLES)
+        return;
+
+    Samples[i].pc = pc;
+    Samples[i].threadID = CurrentlyRunningThread ? CurrentlyRunningThread->threadID : 0;
+    NumberOfSamples = i + 1;
+
+    if (i + 1 == PROFILER_SAMPLES)
+        G8RTOS_PortStopSampler();
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_StartProfiler
+ * INPUTS: (uint32_t) rateHz
+ * OUTPUTS: void
+ * Drops the samples taken so far and samples rateHz
+ * times a second until PROFILER_SAMPLES are taken
+ *  - 2 to 10 kHz keeps the overhead low and still
+ *    catches short functions
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_StartProfiler(uint32_t rateHz)
+{
+    G8RTOS_PortStopSampler();
+
+    NumberOfSamples = 0;
+    SampleRate = rateHz;
+
+    G8RTOS_PortStartSampler(rateHz);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_StopProfiler
+ * INPUTS: void
+ * OUTPUTS: void
+ * Stops sampling, the samples are kept
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_StopProfiler()
+{
+    G8RTOS_PortStopSampler();
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_DumpProfile
+ * INPUTS: void
+ * OUTPUTS: (uint32_t) samples
+ * Stops sampling and writes the samples and the thread
+ * names to the back channel UART, then drops them:
+ *   # G8RTOS profile, rate_hz=R, samples=N
+ *   # anchor,G8RTOS_DumpProfile,<address>
+ *   T,<threadID>,<name>       every live thread
+ *   S,<pc>,<threadID>         every sample
+ *   #end
+ *  - The anchor lets the host script relocate samples
+ *    of position independent host builds
+ *  - Busy waits on the UART, call it from a low
+ *    priority thread
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_DumpProfile()
+{
+    profileThread_t threads[MAX_THREADS];
+    uint32_t numberOfThreads = 0;
+    char line[LINE_LENGTH];
+
+    G8RTOS_PortStopSampler();
+
+    /* copy the thread ring, threads may die while the UART is busy */
+    int32_t status = StartCriticalSection();
+    tcb_t *thread = CurrentlyRunningThread;
+    do {
+        threads[numberOfThreads].threadID = thread->threadID;
+        snprintf(threads[numberOfThreads].threadName, MAX_NAME_LENGTH, "%s", thread->threadName);
+        numberOfThreads++;
+        thread = thread->nextTCB;
+    } while (thread != CurrentlyRunningThread && numberOfThreads < MAX_THREADS);
+    EndCriticalSection(status);
+
+    uint32_t numberOfSamples = NumberOfSamples;
+
+    snprintf(line, LINE_LENGTH, "# G8RTOS profile, rate_hz=%lu, samples=%lu\r\n",
+             (unsigned long)SampleRate, (unsigned long)numberOfSamples);
+    BackChannelWrite(line);
+    snprintf(line, LINE_LENGTH, "# anchor,G8RTOS_DumpProfile,0x%lx\r\n",
+             (unsigned long)(uintptr_t)G8RTOS_DumpProfile);
+    BackChannelWrite(line);
+
+    for (uint32_t i = 0; i < numberOfThreads; i++) {
+        snprintf(line, LINE_LENGTH, "T,%lu,%s\r\n",
+                 (unsigned long)threads[i].threadID, threads[i].threadName);
+        BackChannelWrite(line);
+    }
+
+    for (uint32_t i = 0; i < numberOfSamples; i++) {
+        snprintf(line, LINE_LENGTH, "S,0x%lx,%lu\r\n",
+                 (unsigned long)Samples[i].pc, (unsigned long)Samples[i].threadID);
+        BackChannelWrite(line);
+    }
+
+    BackChannelWrite("#end\r\n");
+
+    NumberOfSamples = 0;
+
+    return numberOfSamples;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_ProfilerThread
+ * INPUTS: void
+ * OUTPUTS: void
+ * Thread that samples windows of PROFILER_SAMPLES at
+ * PROFILER_RATE_HZ and dumps each one
+ *  - Add it at PROFILER_THREAD_PRIORITY
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_ProfilerThread()
+{
+    while(1) {
+        G8RTOS_StartProfiler(PROFILER_RATE_HZ);
+
+        /* sleep through the window, sampling stops once it is full */
+        G8RTOS_Sleep(PROFILER_SAMPLES * 1000 / PROFILER_RATE_HZ + 1);
+
+        G8RTOS_DumpProfile();
+    }
+}
+
+#endif /* G8RTOS_USE_PROFILER */
@@ -0,0 +1,87 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/20/2020                                                |
+ * | SUMMARY: G8RTOS_Profiler.h                                      |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifndef G8RTOS_PROFILER_H_
+#define G8RTOS_PROFILER_H_
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include "G8RTOS_Config.h"
+
+#if G8RTOS_USE_PROFILER
+
+/*
+ * A timer interrupt records the interrupted PC and the
+ * running thread into RAM. G8RTOS_DumpProfile writes
+ * the samples to the back channel UART, which
+ * host/symbolize_profile.py turns into a per function
+ * report using the linker map or ELF
+ */
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_StartProfiler
+ * INPUTS: (uint32_t) rateHz
+ * OUTPUTS: void
+ * Drops the samples taken so far and samples rateHz
+ * times a second until PROFILER_SAMPLES are taken
+ *  - 2 to 10 kHz keeps the overhead low and still
+ *    catches short functions
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_StartProfiler(uint32_t rateHz);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_StopProfiler
+ * INPUTS: void
+ * OUTPUTS: void
+ * Stops sampling, the samples are kept
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_StopProfiler();
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_DumpProfile
+ * INPUTS: void
+ * OUTPUTS: (uint32_t) samples
+ * Stops sampling and writes the samples and the thread
+ * names to the back channel UART, then drops them
+ *  - Busy waits on the UART, call it from a low
+ *    priority thread
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_DumpProfile();
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_ProfilerThread
+ * INPUTS: void
+ * OUTPUTS: void
+ * Thread that samples windows of PROFILER_SAMPLES at
+ * PROFILER_RATE_HZ and dumps each one
+ *  - Add it at PROFILER_THREAD_PRIORITY
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_ProfilerThread();
+
+#endif /* G8RTOS_USE_PROFILER */
+
+#endif /* G8RTOS_PROFILER_H_ */
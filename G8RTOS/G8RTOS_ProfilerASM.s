@@ -0,0 +1,30 @@
+; +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+; | SUMMARY: G8RTOS_ProfilerASM.s                                   |
+; | Holds the ASM entry of the sampling profiler interrupt			|
+; +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+
+	; Functions Defined
+	.def G8RTOS_ProfilerISR
+
+	; Dependencies
+	.ref G8RTOS_PortSamplerHandler
+
+	.thumb		; Set to thumb mode
+	.align 2	; Align by 2 bytes (thumb mode uses allignment by 2 or 4)
+	.text		; Text section
+
+; G8RTOS_ProfilerISR
+; - Timer_A3 handler of the sampling profiler
+;	- Threads and handlers share MSP, so SP points at the exception frame
+;	- Loads the stacked PC (r0, r1, r2, r3, r12, LR, PC, PSR)
+;	- Tail calls G8RTOS_PortSamplerHandler, which returns from the exception
+G8RTOS_ProfilerISR:
+
+	.asmfunc
+
+	ldr r0, [SP, #24]				; r0 = PC of the interrupted code
+	b G8RTOS_PortSamplerHandler		; record it, LR still holds EXC_RETURN
+
+	.endasmfunc
+
+	; end of the asm file
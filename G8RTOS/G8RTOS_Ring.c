@@ -0,0 +1,173 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/13/2020                                                |
+ * | SUMMARY: G8RTOS_Ring.c                                          |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "msp.h"
+#include "G8RTOS_Ring.h"
+#include "G8RTOS_Scheduler.h"
+#include "G8RTOS_Config.h"
+
+#if G8RTOS_USE_IPC
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_InitRing
+ * INPUTS: (ring_t *) ring, (uint32_t *) storage,
+ *         (uint32_t) elementSize, (uint32_t) capacity
+ * OUTPUTS: (int) error
+ * Initializes an empty ring over static storage
+ *  - capacity must be a power of two
+ *  - storage must hold RING_STORAGE_WORDS(elementSize,
+ *    capacity) words
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_InitRing(ring_t *ring, uint32_t *storage, uint32_t elementSize, uint32_t capacity)
+{
+    /* return error code if capacity is not a power of two */
+    if (elementSize == 0 || capacity == 0 || (capacity & (capacity - 1)) != 0)
+        return -1;
+
+    /* assign default values to ring properties */
+    ring->buffer = (uint8_t *)storage;
+    ring->elementSize = elementSize;
+    ring->mask = capacity - 1;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->consumerWaiting = false;
+    ring->overflows = 0;
+
+    /* nothing to notify yet */
+    G8RTOS_InitSemaphore(&ring->notify, 0);
+
+    /* return error code */
+    return 1;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_RingPut
+ * INPUTS: (ring_t *) ring, (const void *) element
+ * OUTPUTS: (bool) put
+ * Appends an element, producer side
+ *  - Returns false and counts an overflow if full
+ *  - Only signals the consumer if it is waiting
+ *  - Safe from ISRs, no critical section
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+bool G8RTOS_RingPut(ring_t *ring, const void *element)
+{
+    uint32_t tail = ring->tail;
+
+    /* count overflow if ring is full */
+    if (tail - ring->head > ring->mask) {
+        ring->overflows++;
+        return false;
+    }
+
+    /* write element into the free slot */
+    memcpy(&ring->buffer[(tail & ring->mask) * ring->elementSize], element, ring->elementSize);
+
+    /* element must be visible before the new tail */
+    __DMB();
+    ring->tail = tail + 1;
+
+    /* tail must be visible before checking for a waiting consumer */
+    __DMB();
+
+    /* only pay for a signal if the consumer sleeps on the ring */
+    if (ring->consumerWaiting) {
+        ring->consumerWaiting = false;
+        G8RTOS_SignalSemaphore(&ring->notify);
+    }
+
+    return true;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_RingGet
+ * INPUTS: (ring_t *) ring, (void *) element
+ * OUTPUTS: (bool) got
+ * Removes the oldest element, consumer side
+ *  - Returns false immediately if the ring is empty
+ *  - No critical section
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+bool G8RTOS_RingGet(ring_t *ring, void *element)
+{
+    uint32_t head = ring->head;
+
+    /* ring is empty */
+    if (ring->tail == head)
+        return false;
+
+    /* tail must be read before the element it publishes */
+    __DMB();
+
+    /* read element from the filled slot */
+    memcpy(element, &ring->buffer[(head & ring->mask) * ring->elementSize], ring->elementSize);
+
+    /* element must be read before the slot is released */
+    __DMB();
+    ring->head = head + 1;
+
+    return true;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_RingGetTimeout
+ * INPUTS: (ring_t *) ring, (void *) element,
+ *         (uint32_t) timeoutMS
+ * OUTPUTS: (bool) got
+ * Removes the oldest element, waiting at most timeoutMS
+ * for the producer
+ *  - Threads only, never call from an ISR
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+bool G8RTOS_RingGetTimeout(ring_t *ring, void *element, uint32_t timeoutMS)
+{
+    uint32_t deadline = SystemTime + timeoutMS;
+
+    while (!G8RTOS_RingGet(ring, element)) {
+        /* announce the wait, then check again so a put in between is not missed */
+        ring->consumerWaiting = true;
+        __DMB();
+        if (ring->tail != ring->head) {
+            ring->consumerWaiting = false;
+            continue;
+        }
+
+        /* give up once the deadline has passed */
+        uint32_t remaining = (timeoutMS == G8RTOS_WAIT_FOREVER) ? G8RTOS_WAIT_FOREVER : deadline - SystemTime;
+        if (remaining == 0 || remaining > timeoutMS ||
+            !G8RTOS_WaitSemaphoreTimeout(&ring->notify, remaining)) {
+            ring->consumerWaiting = false;
+            return G8RTOS_RingGet(ring, element);
+        }
+
+        /* a stale signal may wake the consumer early, the loop checks again */
+    }
+
+    return true;
+}
+
+#endif /* G8RTOS_USE_IPC */
@@ -0,0 +1,123 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/13/2020                                                |
+ * | SUMMARY: G8RTOS_Ring.h                                          |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifndef G8RTOS_RING_H_
+#define G8RTOS_RING_H_
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "G8RTOS_Semaphores.h"
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                        DEFINES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* words of storage needed by a ring */
+#define RING_STORAGE_WORDS(elementSize, capacity) (((elementSize) * (capacity) + 3) / 4)
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                  DATA TYPE DEFINITIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Ring typedef
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef struct ring ring_t;
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Ring
+ * Lock free ring buffer for exactly one producer (e.g.
+ * an ISR) and one consumer thread. head and tail run
+ * freely and are masked into the buffer, head is only
+ * written by the consumer and tail by the producer.
+ * notify is only signaled while consumerWaiting is set
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+struct ring {
+    uint8_t *buffer;
+    uint32_t elementSize;
+    uint32_t mask;
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    volatile bool consumerWaiting;
+    uint32_t overflows;
+    semaphore_t notify;
+};
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_InitRing
+ * INPUTS: (ring_t *) ring, (uint32_t *) storage,
+ *         (uint32_t) elementSize, (uint32_t) capacity
+ * OUTPUTS: (int) error
+ * Initializes an empty ring over static storage
+ *  - capacity must be a power of two
+ *  - storage must hold RING_STORAGE_WORDS(elementSize,
+ *    capacity) words
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_InitRing(ring_t *ring, uint32_t *storage, uint32_t elementSize, uint32_t capacity);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_RingPut
+ * INPUTS: (ring_t *) ring, (const void *) element
+ * OUTPUTS: (bool) put
+ * Appends an element, producer side
+ *  - Returns false and counts an overflow if full
+ *  - Only signals the consumer if it is waiting
+ *  - Safe from ISRs, no critical section
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+bool G8RTOS_RingPut(ring_t *ring, const void *element);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_RingGet
+ * INPUTS: (ring_t *) ring, (void *) element
+ * OUTPUTS: (bool) got
+ * Removes the oldest element, consumer side
+ *  - Returns false immediately if the ring is empty
+ *  - No critical section
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+bool G8RTOS_RingGet(ring_t *ring, void *element);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_RingGetTimeout
+ * INPUTS: (ring_t *) ring, (void *) element,
+ *         (uint32_t) timeoutMS
+ * OUTPUTS: (bool) got
+ * Removes the oldest element, waiting at most timeoutMS
+ * for the producer
+ *  - Threads only, never call from an ISR
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+bool G8RTOS_RingGetTimeout(ring_t *ring, void *element, uint32_t timeoutMS);
+
+#endif /* G8RTOS_RING_H_ */
@@ -13,42 +13,17 @@
  * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
  */
 
-#include <BSP.h>
 #include <stdint.h>
-#include "msp.h"
 #include "G8RTOS_Scheduler.h"
 #include "G8RTOS_Structures.h"
 #include "G8RTOS_CriticalSection.h"
-
-/*
- * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
- * G8RTOS_Start
- * INPUTS: void
- * OUTPUTS: void
- * ASM function to start the G8RTOS
- *  - CRITICAL SECTION
- * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
- */
-extern void G8RTOS_Start();
-
-/* System Core Clock From system_msp432p401r.c */
-extern uint32_t SystemCoreClock;
+#include "G8RTOS_Heap.h"
+#include "G8RTOS_Port.h"
+#include "G8RTOS_Metrics.h"
 
 /* pointer to the currently running Thread Control Block */
 extern tcb_t * CurrentlyRunningThread;
 
-/*
- * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
- *                        DEFINES
- * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
- */
-
-/* Status Register with the Thumb-bit Set */
-#define THUMBBIT 0x01000000
-
-/* desired overflow time for SysTick */
-#define SysTickHigh 0.001f
-
 /*
  * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
  *                  DATA STRUCTURES USED
@@ -73,6 +48,7 @@ static tcb_t threadControlBlocks[MAX_THREADS];
  */
 static int32_t threadStacks[MAX_THREADS][STACKSIZE];
 
+#if G8RTOS_USE_PERIODIC_EVENTS
 /*
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  * Periodic Event Threads
@@ -81,6 +57,7 @@ static int32_t threadStacks[MAX_THREADS][STACKSIZE];
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  */
 static ptcb_t Pthread[MAXPTHREADS];
+#endif
 
 /*
  * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
@@ -91,37 +68,34 @@ static ptcb_t Pthread[MAXPTHREADS];
 /* current number of threads in the scheduler */
 static uint32_t NumberOfThreads;
 
+#if G8RTOS_USE_PERIODIC_EVENTS
 /* current number of periodic threads in the scheduler */
 static uint32_t NumberOfPthreads;
+#endif
 
 /* current number of IDs */
 static uint16_t IDCounter;
 
+/* thread control block filled by the last G8RTOS_AddThread */
+static tcb_t * LastAddedThread;
+
+/* times the scheduler switched to another thread */
+G8RTOS_COUNTER(ContextSwitches, "kernel.switches");
+
+#if G8RTOS_USE_TIME_SLICE
+/* time slice in ms of every priority level */
+static uint8_t TimeSlices[UINT8_MAX + 1];
+
+/* the running thread used up its time slice */
+static bool SliceExpired;
+#endif
+
 /*
  * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
  *                    PRIVATE FUNCTIONS
  * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
  */
 
-/*
- * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
- * InitSysTick
- * INPUTS: (uint32_t) numCycles
- * OUTPUTS: void
- * Initializes the Systick and Systick Interrupt
- *  - The Systick interrupt will be responsible for
- *    starting a context switch between threads
- * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
- */
-static void InitSysTick(uint32_t numCycles)
-{
-    /* configure SysTick */
-    SysTick_Config(numCycles - 1);
-
-    /* enable SysTick interrupts */
-    SysTick_enableInterrupt();
-}
-
 /*
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  * G8RTOS_Scheduler
@@ -130,6 +104,9 @@ static void InitSysTick(uint32_t numCycles)
  * Chooses the next thread to run in the priority
  * cheduler that is neither blocked, sleeping,
  * or dead
+ *  - Once the running thread used up its time slice the
+ *    search starts after it, so a ready peer of the same
+ *    priority runs next
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  */
 void G8RTOS_Scheduler()
@@ -140,10 +117,33 @@ void G8RTOS_Scheduler()
     /* set a temporary next thread */
     tcb_t * tempNextThread = CurrentlyRunningThread;
 
+#if G8RTOS_USE_TRACE || G8RTOS_USE_TIME_SLICE || G8RTOS_USE_METRICS
+    /* thread being switched out */
+    tcb_t * previousThread = CurrentlyRunningThread;
+#endif
+
+#if G8RTOS_USE_TIME_SLICE
+    /* slice used up, equal priority threads after it win ties */
+    if (SliceExpired)
+        tempNextThread = CurrentlyRunningThread->nextTCB;
+#endif
+
     /* traverse through tcb linked list until the highest priority thread is neither sleeping or blocked */
     for (int i = 0; i < NumberOfThreads; i++) {
-        if (!tempNextThread->blocked && !tempNextThread->asleep && tempNextThread->alive) {
-            if (tempNextThread->priority < currentMaxPriority) {
+        if (!tempNextThread->blocked && !tempNextThread->asleep && tempNextThread->alive
+#if G8RTOS_USE_BUDGET
+            /* suspended threads wait for their budget */
+            && !(tempNextThread->throttled && tempNextThread->budgetPolicy == BUDGET_SUSPEND)
+#endif
+            ) {
+            if (tempNextThread->priority < currentMaxPriority
+#if G8RTOS_USE_EDF
+                /* within the EDF band EDF threads beat plain ones, and the earliest absolute deadline wins */
+                || (tempNextThread->edf && tempNextThread->priority == currentMaxPriority &&
+                    (!CurrentlyRunningThread->edf ||
+                     (int32_t)(tempNextThread->absoluteDeadline - CurrentlyRunningThread->absoluteDeadline) < 0))
+#endif
+                ) {
                 /* update currently running thread */
                 CurrentlyRunningThread = tempNextThread;
 
@@ -155,6 +155,28 @@ void G8RTOS_Scheduler()
         /* update temporary next thread to check other threads' priorities */
         tempNextThread = tempNextThread->nextTCB;
     }
+
+#if G8RTOS_USE_STATS
+    CurrentlyRunningThread->runCount++;
+#endif
+
+#if G8RTOS_USE_TIME_SLICE
+    /* switched in threads and expired ones start a fresh slice */
+    if (SliceExpired || CurrentlyRunningThread != previousThread) {
+        CurrentlyRunningThread->sliceRemaining = TimeSlices[CurrentlyRunningThread->priority];
+        SliceExpired = false;
+    }
+#endif
+
+#if G8RTOS_USE_TRACE
+    if (CurrentlyRunningThread != previousThread)
+        G8RTOS_TraceThreadSwitch(previousThread->threadID, CurrentlyRunningThread->threadID);
+#endif
+
+#if G8RTOS_USE_METRICS
+    if (CurrentlyRunningThread != previousThread)
+        G8RTOS_MetricAdd(&ContextSwitches, 1);
+#endif
 }
 
 /*
@@ -166,7 +188,10 @@ void G8RTOS_Scheduler()
  * setting the PendSV flag. Additionally, periodic
  * threads that are ready to execute will be run and
  * sleeping threads that are ready to wake up will be
- * activated
+ * activated. The running thread's time slice is counted
+ * down and its expiry rotates equal priority threads.
+ * The running thread is charged against its budget and
+ * due budgets are replenished
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  */
 void SysTick_Handler()
@@ -174,6 +199,7 @@ void SysTick_Handler()
     /* increment system time */
     SystemTime++;
 
+#if G8RTOS_USE_PERIODIC_EVENTS
     /* temporary periodic thread pointer */
     ptcb_t * Pptr;
 
@@ -191,6 +217,7 @@ void SysTick_Handler()
             (*Pptr->handler)();
         }
     }
+#endif
 
     /* temporary thread pointer */
     tcb_t * ptr = CurrentlyRunningThread->nextTCB;
@@ -198,15 +225,58 @@ void SysTick_Handler()
     /* traverse through tcb linked list to wake up sleeping threads that finished sleeping */
     for (int i = 0; i < NumberOfThreads; i++) {
         /* if thread is asleep and it is done sleeping, wake it up */
-        if (ptr->asleep && ptr->sleepCount == SystemTime)
+        if (ptr->asleep && ptr->sleepCount == SystemTime) {
+            /* ISRs may signal the semaphore the thread waits on */
+            int32_t status = StartCriticalSection();
+
+            /* a thread still blocked timed out, give the semaphore back unless it only selected */
+            if (ptr->blocked) {
+                if (!G8RTOS_IsSelecting(ptr))
+                    (*ptr->blocked)++;
+                ptr->blocked = 0;
+                ptr->timedOut = true;
+            }
+
             ptr->asleep = false;
 
+            EndCriticalSection(status);
+        }
+
+#if G8RTOS_USE_BUDGET
+        /* replenish budget and lift throttling */
+        if (ptr->budget && ptr->replenishTime == SystemTime) {
+            ptr->budgetRemaining = ptr->budget;
+            ptr->replenishTime += ptr->replenishPeriod;
+            ptr->priority = ptr->basePriority;
+            ptr->throttled = false;
+        }
+#endif
+
         /* point to next thread */
         ptr = ptr->nextTCB;
     }
 
+#if G8RTOS_USE_TIME_SLICE
+    /* count down the running thread's slice */
+    if (CurrentlyRunningThread->sliceRemaining && --CurrentlyRunningThread->sliceRemaining == 0) {
+        CurrentlyRunningThread->sliceExpiries++;
+        SliceExpired = true;
+    }
+#endif
+
+#if G8RTOS_USE_BUDGET
+    /* charge the running thread and throttle it once its budget is used up */
+    if (CurrentlyRunningThread->budget && !CurrentlyRunningThread->throttled &&
+        --CurrentlyRunningThread->budgetRemaining == 0) {
+        CurrentlyRunningThread->overruns++;
+        CurrentlyRunningThread->throttled = true;
+        if (CurrentlyRunningThread->budgetPolicy == BUDGET_DEMOTE)
+            CurrentlyRunningThread->priority = BUDGET_DEMOTE_PRIORITY;
+    }
+#endif
+
     /* set PendSV flag to start context switch */
-    SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+    G8RTOS_PortYield();
 }
 
 /*
@@ -243,13 +313,23 @@ void G8RTOS_Init()
     /* init IDCounter */
     IDCounter = 0;
 
-    /* init all hardware on board */
-    BSP_InitBoard();
+    /* kernel metrics */
+    G8RTOS_RegisterMetric(&ContextSwitches);
 
-    /* relocate ISRs interrupt vectors to SRAM */
-    uint32_t newVTORTable = 0x20000000;
-    memcpy((uint32_t *)newVTORTable, (uint32_t *)SCB->VTOR, 57*4);
-    SCB->VTOR = newVTORTable;
+#if G8RTOS_USE_HEAP
+    /* init heap as one free block */
+    G8RTOS_InitHeap();
+#endif
+
+#if G8RTOS_USE_TIME_SLICE
+    /* every priority starts with the default slice */
+    for (int i = 0; i <= UINT8_MAX; i++)
+        TimeSlices[i] = TIME_SLICE_MS;
+    SliceExpired = false;
+#endif
+
+    /* init all hardware on board and relocate ISRs interrupt vectors */
+    G8RTOS_PortInit();
 }
 
 /*
@@ -266,14 +346,8 @@ void G8RTOS_Init()
  */
 int G8RTOS_Launch()
 {
-    /* set SysTick to lowest priority */
-    NVIC_SetPriority(SysTick_IRQn, OSINT_PRIORITY);
-
-    /* set PendSV to lowest priority */
-    NVIC_SetPriority(PendSV_IRQn, OSINT_PRIORITY);
-
-    /* set SysTick interrupt every 1 ms */
-    InitSysTick(ClockSys_GetSysFreq() * SysTickHigh);
+    /* set SysTick & PendSV to lowest priority and interrupt every 1 ms */
+    G8RTOS_PortStartTick();
 
     /* set a default max priority */
     uint8_t currentMaxPriority = UINT8_MAX;
@@ -290,12 +364,26 @@ int G8RTOS_Launch()
     }
 
     /* set context of first thread */
-    G8RTOS_Start();
+    G8RTOS_PortStart();
 
     /* return error code */
     return NO_THREADS_SCHEDULED;
 }
 
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_IsRunning
+ * INPUTS: void
+ * OUTPUTS: (bool) running
+ * True once G8RTOS_Launch has picked the first thread,
+ * so code shared with startup knows it may sleep
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+bool G8RTOS_IsRunning()
+{
+    return CurrentlyRunningThread != 0;
+}
+
 /*
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  * G8RTOS_AddThread
@@ -366,10 +454,30 @@ int G8RTOS_AddThread(void (*threadToAdd)(void), uint8_t priority, char * name)
 
     /* assign default values to thread properties */
     threadControlBlocks[i].blocked = 0;
+    threadControlBlocks[i].selectSet = 0;
+    threadControlBlocks[i].selectCount = 0;
     threadControlBlocks[i].sleepCount = 0;
     threadControlBlocks[i].asleep = false;
+    threadControlBlocks[i].timedOut = false;
     threadControlBlocks[i].priority = priority;
     threadControlBlocks[i].alive = true;
+#if G8RTOS_USE_STATS
+    threadControlBlocks[i].runCount = 0;
+#endif
+#if G8RTOS_USE_EDF
+    threadControlBlocks[i].edf = false;
+    threadControlBlocks[i].absoluteDeadline = 0;
+#endif
+#if G8RTOS_USE_TIME_SLICE
+    threadControlBlocks[i].sliceRemaining = TimeSlices[priority];
+    threadControlBlocks[i].sliceExpiries = 0;
+#endif
+#if G8RTOS_USE_BUDGET
+    threadControlBlocks[i].budget = 0;
+    threadControlBlocks[i].basePriority = priority;
+    threadControlBlocks[i].throttled = false;
+    threadControlBlocks[i].overruns = 0;
+#endif
 
     /* assign thread id */
     threadControlBlocks[i].threadID = ((IDCounter++) << 16) | i;
@@ -379,29 +487,86 @@ int G8RTOS_AddThread(void (*threadToAdd)(void), uint8_t priority, char * name)
     while (*name)
         threadControlBlocks[i].threadName[name_offset++] = *name++;
 
-    /* store sp of thread */
-    threadControlBlocks[i].stackPointer = &threadStacks[i][STACKSIZE - 16];
-
-    /* store context */
-    threadStacks[i][STACKSIZE - 1] = THUMBBIT;                // PSR w/ thumbit enabled
-    threadStacks[i][STACKSIZE - 2] = (int32_t)(threadToAdd);  // PC w/ functiooon pointer to thread
-    threadStacks[i][STACKSIZE - 3] = 0x14141414;              // LR w/ dummy data
-    threadStacks[i][STACKSIZE - 4] = 0x12121212;              // r12 w/ dummy data
-    threadStacks[i][STACKSIZE - 5] = 0x03030303;              // r3 w/ dummy data
-    threadStacks[i][STACKSIZE - 6] = 0x02020202;              // r2 w/ dummy data
-    threadStacks[i][STACKSIZE - 7] = 0x01010101;              // r1 w/ dummy data
-    threadStacks[i][STACKSIZE - 8] = 0x00000000;              // r0 w/ dummy data
-    threadStacks[i][STACKSIZE - 9] = 0x11111111;              // r11 w/ dummy data
-    threadStacks[i][STACKSIZE - 10] = 0x10101010;             // r10 w/ dummy data
-    threadStacks[i][STACKSIZE - 11] = 0x09090909;             // r9 w/ dummy data
-    threadStacks[i][STACKSIZE - 12] = 0x08080808;             // r8 w/ dummy data
-    threadStacks[i][STACKSIZE - 13] = 0x07070707;             // r7 w/ dummy data
-    threadStacks[i][STACKSIZE - 14] = 0x06060606;             // r6 w/ dummy data
-    threadStacks[i][STACKSIZE - 15] = 0x05050505;             // r5 w/ dummy data
-    threadStacks[i][STACKSIZE - 16] = 0x04040404;             // r4 w/ dummy data
+    /* store context and sp of thread */
+    threadControlBlocks[i].stackPointer = G8RTOS_PortInitStack(i, threadStacks[i], threadToAdd);
 
     /* increment number of threads */
     NumberOfThreads++;
+    LastAddedThread = &threadControlBlocks[i];
+
+#if G8RTOS_USE_TRACE
+    G8RTOS_TraceThreadAdded(threadControlBlocks[i].threadID);
+#endif
+
+    /* end critical section and enable interrupts */
+    EndCriticalSection(status);
+
+    /* return error code */
+    return NO_ERROR;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_AddThreads
+ * INPUTS: (const threadConfig_t *) threads,
+ *         (uint32_t) count
+ * OUTPUTS: (int) error
+ * Adds every thread of a static table in order
+ *  - Stops at and returns the first error
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_AddThreads(const threadConfig_t *threads, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        /* return error code of the first thread that could not be added */
+        int error = G8RTOS_AddThread(threads[i].thread, threads[i].priority, threads[i].name);
+        if (error != NO_ERROR)
+            return error;
+    }
+
+    /* return error code */
+    return NO_ERROR;
+}
+
+#if G8RTOS_USE_EDF
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_AddEDFThread
+ * INPUTS: (void)(* threadToAdd)(void), (uint32_t) periodMS,
+ *         (uint32_t) deadlineMS, (char)(* name)
+ * OUTPUTS: (int) error
+ * Adds a periodic thread to the EDF band
+ *  - Runs at EDF_PRIORITY, among EDF threads the one
+ *    with the earliest absolute deadline runs, ahead
+ *    of plain threads added at EDF_PRIORITY
+ *  - The first job is released right away, the thread
+ *    calls G8RTOS_WaitNextPeriod after each job
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_AddEDFThread(void (*threadToAdd)(void), uint32_t periodMS, uint32_t deadlineMS, char * name)
+{
+    /* return error code if the thread could never be released */
+    if (periodMS == 0 || deadlineMS == 0)
+        return PERIOD_INVALID;
+
+    /* start critical section & disable interrupts */
+    int32_t status = StartCriticalSection();
+
+    /* add thread at the EDF band priority */
+    int error = G8RTOS_AddThread(threadToAdd, EDF_PRIORITY, name);
+    if (error != NO_ERROR) {
+        EndCriticalSection(status);
+        return error;
+    }
+
+    /* release first job now */
+    LastAddedThread->edf = true;
+    LastAddedThread->period = periodMS;
+    LastAddedThread->relativeDeadline = deadlineMS;
+    LastAddedThread->release = SystemTime;
+    LastAddedThread->absoluteDeadline = SystemTime + deadlineMS;
+    LastAddedThread->deadlineMisses = 0;
 
     /* end critical section and enable interrupts */
     EndCriticalSection(status);
@@ -410,6 +575,63 @@ int G8RTOS_AddThread(void (*threadToAdd)(void), uint8_t priority, char * name)
     return NO_ERROR;
 }
 
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_WaitNextPeriod
+ * INPUTS: void
+ * OUTPUTS: (uint32_t) lateness
+ * Ends the current job of an EDF thread and sleeps
+ * until the next release
+ *  - Returns the ms the job finished after its absolute
+ *    deadline and counts a deadline miss, 0 if on time
+ *  - Skips releases that already passed
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_WaitNextPeriod()
+{
+    tcb_t * thread = CurrentlyRunningThread;
+    uint32_t lateness = 0;
+
+    /* start critical section & disable interrupts */
+    int32_t status = StartCriticalSection();
+
+    /* count a miss if the job finished after its deadline */
+    if ((int32_t)(SystemTime - thread->absoluteDeadline) > 0) {
+        lateness = SystemTime - thread->absoluteDeadline;
+        thread->deadlineMisses++;
+    }
+
+    /* next release */
+    thread->release += thread->period;
+
+    /* release already past, run the latest one right away */
+    if ((int32_t)(SystemTime - thread->release) >= 0) {
+        thread->release += ((SystemTime - thread->release) / thread->period) * thread->period;
+        thread->absoluteDeadline = thread->release + thread->relativeDeadline;
+
+        /* end critical section and enable interrupts */
+        EndCriticalSection(status);
+
+        return lateness;
+    }
+
+    /* sleep thread until the release */
+    thread->absoluteDeadline = thread->release + thread->relativeDeadline;
+    thread->sleepCount = thread->release;
+    thread->asleep = true;
+
+    /* end critical section and enable interrupts */
+    EndCriticalSection(status);
+
+    /* set PendSV flag to start scheduler */
+    G8RTOS_PortYield();
+
+    return lateness;
+}
+#endif
+
+#if G8RTOS_USE_PERIODIC_EVENTS
 /*
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  * G8RTOS_AddPeriodicEvent
@@ -461,6 +683,7 @@ int G8RTOS_AddPeriodicEvent(void (*PthreadToAdd)(void), uint32_t period)
     /* return error code */
     return NO_ERROR;
 }
+#endif
 
 /*
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
@@ -498,9 +721,7 @@ sched_ErrCode_t G8RTOS_AddAperiodicEvent(void (*AthreadToAdd)(void), uint8_t pri
 
 
     /* initialize NVIC registers */
-    __NVIC_SetVector(IRQn, (uint32_t)AthreadToAdd);
-    __NVIC_SetPriority(IRQn, priority);
-    NVIC_EnableIRQ(IRQn);
+    G8RTOS_PortEnableIRQ(IRQn, AthreadToAdd, priority);
 
     /* end critical section and enable interrupts */
     EndCriticalSection(status);
@@ -526,7 +747,54 @@ void G8RTOS_Sleep(uint32_t durationMS)
     CurrentlyRunningThread->asleep = true;
 
     /* set PendSV flag to start scheduler */
-    SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+    G8RTOS_PortYield();
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_SleepUntil
+ * INPUTS: (uint32_t *) lastWake, (uint32_t) periodMS
+ * OUTPUTS: (uint32_t) overrun
+ * Sleeps until periodMS after *lastWake and advances
+ * *lastWake by one period, so loops keep a fixed release
+ * cadence regardless of their execution time
+ *  - Initialize *lastWake to SystemTime before the loop
+ *  - If the release is already past it does not sleep,
+ *    skips missed releases and returns the ms it is late
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_SleepUntil(uint32_t *lastWake, uint32_t periodMS)
+{
+    /* start critical section & disable interrupts */
+    int32_t status = StartCriticalSection();
+
+    /* time since the last release, wrap safe */
+    uint32_t elapsed = SystemTime - *lastWake;
+
+    /* release already past, keep the cadence but skip missed releases */
+    if (elapsed >= periodMS) {
+        uint32_t overrun = elapsed - periodMS;
+        *lastWake += periodMS + (overrun / periodMS) * periodMS;
+
+        /* end critical section and enable interrupts */
+        EndCriticalSection(status);
+
+        return overrun;
+    }
+
+    /* sleep thread until the next release */
+    *lastWake += periodMS;
+    CurrentlyRunningThread->sleepCount = *lastWake;
+    CurrentlyRunningThread->asleep = true;
+
+    /* end critical section and enable interrupts */
+    EndCriticalSection(status);
+
+    /* set PendSV flag to start scheduler */
+    G8RTOS_PortYield();
+
+    return 0;
 }
 
 /*
@@ -542,6 +810,130 @@ threadID_t G8RTOS_GetThreadId()
     return CurrentlyRunningThread->threadID;
 }
 
+#if G8RTOS_USE_TIME_SLICE
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_SetTimeSlice
+ * INPUTS: (uint8_t) priority, (uint8_t) sliceMS
+ * OUTPUTS: void
+ * Sets how many ms threads of a priority run before a
+ * ready thread of the same priority takes over
+ *  - A slice of 0 never rotates, threads of that
+ *    priority run until they block or sleep
+ *  - Takes effect at each thread's next slice
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_SetTimeSlice(uint8_t priority, uint8_t sliceMS)
+{
+    TimeSlices[priority] = sliceMS;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_GetSliceExpiries
+ * INPUTS: (threadID_t) threadId
+ * OUTPUTS: (uint32_t) expiries
+ * Gets how many time slices a thread used up without
+ * blocking or sleeping
+ *  - Returns 0 if the thread does not exist
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_GetSliceExpiries(threadID_t threadId)
+{
+    /* find thread */
+    for (int i = 0; i < MAX_THREADS; i++) {
+        if (threadControlBlocks[i].threadID == threadId && threadControlBlocks[i].alive)
+            return threadControlBlocks[i].sliceExpiries;
+    }
+
+    return 0;
+}
+#endif
+
+#if G8RTOS_USE_BUDGET
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_SetThreadBudget
+ * INPUTS: (threadID_t) threadId, (uint32_t) budgetMS,
+ *         (uint32_t) periodMS, (budgetPolicy_t) policy
+ * OUTPUTS: (sched_ErrCode_t) error
+ * Limits a thread to budgetMS of CPU every periodMS
+ *  - CPU time is charged one ms to the thread running
+ *    at each SysTick
+ *  - A thread that uses up its budget counts an overrun
+ *    and follows policy until the budget is replenished
+ *  - The budget is replenished in full every periodMS,
+ *    starting periodMS from now
+ *  - A budget of 0 removes the limit
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+sched_ErrCode_t G8RTOS_SetThreadBudget(threadID_t threadId, uint32_t budgetMS,
+                                       uint32_t periodMS, budgetPolicy_t policy)
+{
+    /* return error code if the budget could never be replenished */
+    if (budgetMS && (periodMS == 0 || budgetMS > periodMS))
+        return PERIOD_INVALID;
+
+    /* start critical section & disable interrupts */
+    int32_t status = StartCriticalSection();
+
+    /* thread offset */
+    int i = 0;
+
+    /* find thread */
+    while (i < MAX_THREADS) {
+        if (threadControlBlocks[i].threadID == threadId && threadControlBlocks[i].alive == true)
+            break;
+        i++;
+    }
+
+    /* check if thread exists */
+    if (i == MAX_THREADS) {
+        /* end critical section and enable interrupts */
+        EndCriticalSection(status);
+
+        /* return error code */
+        return THREAD_DOES_NOT_EXIST;
+    }
+
+    /* lift any throttling and start a full budget */
+    threadControlBlocks[i].priority = threadControlBlocks[i].basePriority;
+    threadControlBlocks[i].throttled = false;
+    threadControlBlocks[i].budget = budgetMS;
+    threadControlBlocks[i].budgetRemaining = budgetMS;
+    threadControlBlocks[i].replenishPeriod = periodMS;
+    threadControlBlocks[i].replenishTime = SystemTime + periodMS;
+    threadControlBlocks[i].budgetPolicy = policy;
+
+    /* end critical section and enable interrupts */
+    EndCriticalSection(status);
+
+    /* return error code */
+    return NO_ERROR;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_GetBudgetOverruns
+ * INPUTS: (threadID_t) threadId
+ * OUTPUTS: (uint32_t) overruns
+ * Gets how many periods a thread used up its budget in
+ *  - Returns 0 if the thread does not exist
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_GetBudgetOverruns(threadID_t threadId)
+{
+    /* find thread */
+    for (int i = 0; i < MAX_THREADS; i++) {
+        if (threadControlBlocks[i].threadID == threadId && threadControlBlocks[i].alive)
+            return threadControlBlocks[i].overruns;
+    }
+
+    return 0;
+}
+#endif
+
 /*
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  * G8RTOS_KillThread
@@ -587,11 +979,16 @@ sched_ErrCode_t G8RTOS_KillThread(threadID_t threadId)
         return THREAD_DOES_NOT_EXIST;
     }
 
+#if G8RTOS_USE_TRACE
+    G8RTOS_TraceThreadKilled(threadId);
+#endif
+
     /* kill thread and adjust doubly linked list */
     threadControlBlocks[i].alive = false;
     threadControlBlocks[i].previousTCB->nextTCB = threadControlBlocks[i].nextTCB;
     threadControlBlocks[i].nextTCB->previousTCB = threadControlBlocks[i].previousTCB;
     threadControlBlocks[i].asleep = false;
+    G8RTOS_CancelSelect(&threadControlBlocks[i]);
     threadControlBlocks[i].blocked = false;
     threadControlBlocks[i].priority = 255;
     threadControlBlocks[i].sleepCount = 0;
@@ -610,7 +1007,7 @@ sched_ErrCode_t G8RTOS_KillThread(threadID_t threadId)
         EndCriticalSection(status);
 
         /* set PendSV flag to start scheduler */
-        SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+        G8RTOS_PortYield();
 
         /* return error code */
         return NO_ERROR;
@@ -632,6 +1029,8 @@ sched_ErrCode_t G8RTOS_KillThread(threadID_t threadId)
  *  - Kills currently running thread and context switches
  *    to next thread
  *  - Readjusts doubly linked list when thread is killed
+ *  - Only returns on error, if no other thread is ready
+ *    it idles until one is
  *  - CRITICAL SECTION
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  */
@@ -649,11 +1048,16 @@ sched_ErrCode_t G8RTOS_KillSelf()
         return CANNOT_KILL_LAST_THREAD;
     }
 
+#if G8RTOS_USE_TRACE
+    G8RTOS_TraceThreadKilled(CurrentlyRunningThread->threadID);
+#endif
+
     /* kill thread and adjust doubly linked list */
     CurrentlyRunningThread->alive = false;
     CurrentlyRunningThread->previousTCB->nextTCB = CurrentlyRunningThread->nextTCB;
     CurrentlyRunningThread->nextTCB->previousTCB = CurrentlyRunningThread->previousTCB;
     CurrentlyRunningThread->asleep = false;
+    G8RTOS_CancelSelect(CurrentlyRunningThread);
     CurrentlyRunningThread->blocked = false;
 
     /* decrement number of threads */
@@ -667,10 +1071,10 @@ sched_ErrCode_t G8RTOS_KillSelf()
     EndCriticalSection(status);
 
     /* set PendSV flag to start scheduler */
-    SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+    G8RTOS_PortYield();
 
-    /* return error code */
-    return NO_ERROR;
+    /* with no other thread ready the switch stays on this tcb, idle until the tick picks one */
+    while (1);
 }
 
 /*
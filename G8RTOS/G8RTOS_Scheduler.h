@@ -10,18 +10,9 @@
 #ifndef G8RTOS_SCHEDULER_H_
 #define G8RTOS_SCHEDULER_H_
 
+#include <stdbool.h>
 #include "msp.h"
-
-/*
- * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
- *                        DEFINES
- * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
- */
-
-#define MAX_THREADS 20
-#define MAXPTHREADS 6
-#define STACKSIZE 512
-#define OSINT_PRIORITY 7
+#include "G8RTOS_Config.h"
 
 /*
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
@@ -43,9 +34,59 @@ typedef enum {
     THREAD_DOES_NOT_EXIST = -4,
     CANNOT_KILL_LAST_THREAD = -5,
     IRQn_INVALID = -6,
-    HWI_PRIORITY_INVALID = -7
+    HWI_PRIORITY_INVALID = -7,
+    PERIOD_INVALID = -8,
+    PIN_INVALID = -9
 } sched_ErrCode_t;
 
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Thread configuration typedef
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef struct threadConfig threadConfig_t;
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Thread configuration
+ * One entry of a static thread table passed to
+ * G8RTOS_AddThreads
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+struct threadConfig {
+    void (*thread)(void);
+    uint8_t priority;
+    char *name;
+};
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Budget policy
+ * What happens to a thread that used up its CPU budget
+ * until the budget is replenished
+ *  - BUDGET_DEMOTE: runs at BUDGET_DEMOTE_PRIORITY
+ *  - BUDGET_SUSPEND: is not scheduled at all
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef enum
+{
+    BUDGET_DEMOTE = 0,
+    BUDGET_SUSPEND = 1
+} budgetPolicy_t;
+
+#if G8RTOS_USE_TRACE
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                      TRACE HOOKS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* implemented by the application, called with interrupts disabled */
+void G8RTOS_TraceThreadAdded(threadID_t threadID);
+void G8RTOS_TraceThreadKilled(threadID_t threadID);
+void G8RTOS_TraceThreadSwitch(threadID_t from, threadID_t to);
+#endif
+
 /*
  * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
  *                    PUBLIC VARIABLES
@@ -85,6 +126,17 @@ void G8RTOS_Init();
  */
 int G8RTOS_Launch();
 
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_IsRunning
+ * INPUTS: void
+ * OUTPUTS: (bool) running
+ * True once G8RTOS_Launch has picked the first thread,
+ * so code shared with startup knows it may sleep
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+bool G8RTOS_IsRunning();
+
 /*
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  * G8RTOS_AddThread
@@ -102,6 +154,53 @@ int G8RTOS_Launch();
  */
 int G8RTOS_AddThread(void (*threadToAdd)(void), uint8_t priority, char * name);
 
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_AddThreads
+ * INPUTS: (const threadConfig_t *) threads,
+ *         (uint32_t) count
+ * OUTPUTS: (int) error
+ * Adds every thread of a static table in order
+ *  - Stops at and returns the first error
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_AddThreads(const threadConfig_t *threads, uint32_t count);
+
+#if G8RTOS_USE_EDF
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_AddEDFThread
+ * INPUTS: (void)(* threadToAdd)(void), (uint32_t) periodMS,
+ *         (uint32_t) deadlineMS, (char)(* name)
+ * OUTPUTS: (int) error
+ * Adds a periodic thread to the EDF band
+ *  - Runs at EDF_PRIORITY, among EDF threads the one
+ *    with the earliest absolute deadline runs, ahead
+ *    of plain threads added at EDF_PRIORITY
+ *  - The first job is released right away, the thread
+ *    calls G8RTOS_WaitNextPeriod after each job
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_AddEDFThread(void (*threadToAdd)(void), uint32_t periodMS, uint32_t deadlineMS, char * name);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_WaitNextPeriod
+ * INPUTS: void
+ * OUTPUTS: (uint32_t) lateness
+ * Ends the current job of an EDF thread and sleeps
+ * until the next release
+ *  - Returns the ms the job finished after its absolute
+ *    deadline and counts a deadline miss, 0 if on time
+ *  - Skips releases that already passed
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_WaitNextPeriod();
+#endif
+
+#if G8RTOS_USE_PERIODIC_EVENTS
 /*
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  * G8RTOS_AddPeriodicEvent
@@ -116,6 +215,7 @@ int G8RTOS_AddThread(void (*threadToAdd)(void), uint8_t priority, char * name);
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  */
 int G8RTOS_AddPeriodicEvent(void (*PthreadToAdd)(void), uint32_t period);
+#endif
 
 /*
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
@@ -127,6 +227,22 @@ int G8RTOS_AddPeriodicEvent(void (*PthreadToAdd)(void), uint32_t period);
  */
 void G8RTOS_Sleep(uint32_t durationMS);
 
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_SleepUntil
+ * INPUTS: (uint32_t *) lastWake, (uint32_t) periodMS
+ * OUTPUTS: (uint32_t) overrun
+ * Sleeps until periodMS after *lastWake and advances
+ * *lastWake by one period, so loops keep a fixed release
+ * cadence regardless of their execution time
+ *  - Initialize *lastWake to SystemTime before the loop
+ *  - If the release is already past it does not sleep,
+ *    skips missed releases and returns the ms it is late
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_SleepUntil(uint32_t *lastWake, uint32_t periodMS);
+
 /*
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  * G8RTOS_AddAperiodicEvent
@@ -150,6 +266,79 @@ sched_ErrCode_t G8RTOS_AddAperiodicEvent(void (*AthreadToAdd)(void), uint8_t pri
  */
 threadID_t G8RTOS_GetThreadId();
 
+#if G8RTOS_USE_TIME_SLICE
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_SetTimeSlice
+ * INPUTS: (uint8_t) priority, (uint8_t) sliceMS
+ * OUTPUTS: void
+ * Sets how many ms threads of a priority run before a
+ * ready thread of the same priority takes over
+ *  - A slice of 0 never rotates, threads of that
+ *    priority run until they block or sleep
+ *  - Takes effect at each thread's next slice
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_SetTimeSlice(uint8_t priority, uint8_t sliceMS);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_GetSliceExpiries
+ * INPUTS: (threadID_t) threadId
+ * OUTPUTS: (uint32_t) expiries
+ * Gets how many time slices a thread used up without
+ * blocking or sleeping
+ *  - Returns 0 if the thread does not exist
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_GetSliceExpiries(threadID_t threadId);
+#endif
+
+#if G8RTOS_USE_BUDGET
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_SetThreadBudget
+ * INPUTS: (threadID_t) threadId, (uint32_t) budgetMS,
+ *         (uint32_t) periodMS, (budgetPolicy_t) policy
+ * OUTPUTS: (sched_ErrCode_t) error
+ * Limits a thread to budgetMS of CPU every periodMS
+ *  - CPU time is charged one ms to the thread running
+ *    at each SysTick
+ *  - A thread that uses up its budget counts an overrun
+ *    and follows policy until the budget is replenished
+ *  - The budget is replenished in full every periodMS,
+ *    starting periodMS from now
+ *  - A budget of 0 removes the limit
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+sched_ErrCode_t G8RTOS_SetThreadBudget(threadID_t threadId, uint32_t budgetMS,
+                                       uint32_t periodMS, budgetPolicy_t policy);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_GetBudgetOverruns
+ * INPUTS: (threadID_t) threadId
+ * OUTPUTS: (uint32_t) overruns
+ * Gets how many periods a thread used up its budget in
+ *  - Returns 0 if the thread does not exist
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_GetBudgetOverruns(threadID_t threadId);
+#else
+/* without budgets threads are never limited, callers need no #if */
+static inline sched_ErrCode_t G8RTOS_SetThreadBudget(threadID_t threadId, uint32_t budgetMS,
+                                                     uint32_t periodMS, budgetPolicy_t policy)
+{
+    return NO_ERROR;
+}
+
+static inline uint32_t G8RTOS_GetBudgetOverruns(threadID_t threadId)
+{
+    return 0;
+}
+#endif
+
 /*
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  * G8RTOS_KillThread
@@ -173,6 +362,8 @@ sched_ErrCode_t G8RTOS_KillThread(threadID_t threadId);
  *  - Kills currently running thread and context switches
  *    to next thread
  *  - Readjusts doubly linked list when thread is killed
+ *  - Only returns on error, if no other thread is ready
+ *    it idles until one is
  *  - CRITICAL SECTION
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  */
@@ -15,9 +15,76 @@
 
 #include <stdint.h>
 #include "msp.h"
+#include "G8RTOS_Port.h"
 #include "G8RTOS_Semaphores.h"
 #include "G8RTOS_CriticalSection.h"
 #include "G8RTOS_Structures.h"
+#include "G8RTOS_Scheduler.h"
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                   PRIVATE VARIABLES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* threads waiting in G8RTOS_Select are blocked on this, its count is never used */
+static semaphore_t SelectSentinel;
+
+/* number of threads waiting in G8RTOS_Select */
+static uint32_t SelectWaiters;
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PRIVATE FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * ReadyMask
+ * INPUTS: (semaphore_t * const *) set, (uint32_t) count
+ * OUTPUTS: (uint32_t) ready
+ * Sets bit i for every available semaphore set[i]
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static uint32_t ReadyMask(semaphore_t * const *set, uint32_t count)
+{
+    uint32_t ready = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+        if (*set[i] > 0)
+            ready |= 1u << i;
+
+    return ready;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * WakeSelectors
+ * INPUTS: (semaphore_t *) s
+ * OUTPUTS: void
+ * Unblocks every thread selecting on s
+ *  - Must be called inside a critical section
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void WakeSelectors(semaphore_t *s)
+{
+    tcb_t *ptr = CurrentlyRunningThread;
+
+    /* visit every TCB once */
+    do {
+        if (ptr->blocked == &SelectSentinel) {
+            for (uint32_t i = 0; i < ptr->selectCount; i++) {
+                if (ptr->selectSet[i] == s) {
+                    ptr->blocked = 0;
+                    ptr->asleep = false;
+                    break;
+                }
+            }
+        }
+        ptr = ptr->nextTCB;
+    } while (ptr != CurrentlyRunningThread);
+}
 
 /*
  * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
@@ -46,6 +113,21 @@ void G8RTOS_InitSemaphore(semaphore_t *s, int32_t value)
     EndCriticalSection(state);
 }
 
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_InitSemaphores
+ * INPUTS: (const semaphoreConfig_t *) semaphores,
+ *         (uint32_t) count
+ * OUTPUTS: void
+ * Initializes every semaphore of a static table
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_InitSemaphores(const semaphoreConfig_t *semaphores, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        G8RTOS_InitSemaphore(semaphores[i].semaphore, semaphores[i].value);
+}
+
 /*
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  * G8RTOS_WaitSemaphore
@@ -75,11 +157,111 @@ void G8RTOS_WaitSemaphore(semaphore_t *s)
         EndCriticalSection(state);
 
         /* call PendSV */
-        SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+        G8RTOS_PortYield();
+    }
+
+    /* end critical section & enable interrupts */
+    EndCriticalSection(state);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_TryWaitSemaphore
+ * INPUTS: (semaphore_t *) s
+ * OUTPUTS: (bool) acquired
+ * Takes a semaphore only if it is available ((*s) > 0)
+ *  - Decrements semaphore and returns true when available
+ *  - Returns false without blocking otherwise
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+bool G8RTOS_TryWaitSemaphore(semaphore_t *s)
+{
+    /* start critical section & disable interrupts */
+    int32_t state = StartCriticalSection();
+
+    /* semaphore is unavailable, leave it untouched */
+    if ((*s) <= 0) {
+        /* end critical section & enable interrupts */
+        EndCriticalSection(state);
+
+        return false;
+    }
+
+    /* decrement semaphore */
+    (*s)--;
+
+    /* end critical section & enable interrupts */
+    EndCriticalSection(state);
+
+    return true;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_WaitSemaphoreTimeout
+ * INPUTS: (semaphore_t *) s, (uint32_t) timeoutMS
+ * OUTPUTS: (bool) acquired
+ * Waits at most timeoutMS for a semaphore to be
+ * available ((*s) > 0)
+ *  - Decrements semaphore and returns true when available
+ *  - Blocks and sleeps the thread if unavailable, the
+ *    SysTick handler gives the semaphore back and
+ *    returns false once the timeout expires
+ *  - A timeout of 0 never blocks, G8RTOS_WAIT_FOREVER
+ *    never times out
+ *  - Threads only, never call from an ISR
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+bool G8RTOS_WaitSemaphoreTimeout(semaphore_t *s, uint32_t timeoutMS)
+{
+    /* waiting forever is a regular wait */
+    if (timeoutMS == G8RTOS_WAIT_FOREVER) {
+        G8RTOS_WaitSemaphore(s);
+        return true;
+    }
+
+    /* start critical section & disable interrupts */
+    int32_t state = StartCriticalSection();
+
+    /* take semaphore if it is available */
+    if ((*s) > 0) {
+        (*s)--;
+
+        /* end critical section & enable interrupts */
+        EndCriticalSection(state);
+
+        return true;
+    }
+
+    /* do not block without a timeout */
+    if (timeoutMS == 0) {
+        /* end critical section & enable interrupts */
+        EndCriticalSection(state);
+
+        return false;
     }
 
+    /* decrement semaphore */
+    (*s)--;
+
+    /* block thread and sleep it until the timeout */
+    CurrentlyRunningThread->blocked = s;
+    CurrentlyRunningThread->timedOut = false;
+    CurrentlyRunningThread->sleepCount = timeoutMS + SystemTime;
+    CurrentlyRunningThread->asleep = true;
+
     /* end critical section & enable interrupts */
     EndCriticalSection(state);
+
+    /* call PendSV and flush pipelines so the switch happens before returning */
+    G8RTOS_PortYield();
+    __DSB();
+    __ISB();
+
+    /* thread resumes once signaled or timed out */
+    return !CurrentlyRunningThread->timedOut;
 }
 
 /*
@@ -90,6 +272,7 @@ void G8RTOS_WaitSemaphore(semaphore_t *s)
  * Signals the completion of the usage of a semaphore
  *  - Increments semaphore by 1
  *  - Unblocks first thread with the blocked semaphore
+ *  - Otherwise wakes threads selecting on it
  *  - CRITICAL SECTION
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  */
@@ -112,10 +295,126 @@ void G8RTOS_SignalSemaphore(semaphore_t *s)
         while (ptr->blocked != s)
             ptr = ptr->nextTCB;
 
-        /* free blocked thread */
+        /* free blocked thread, waking it if it waits with a timeout */
         ptr->blocked = 0;
+        ptr->asleep = false;
+    }
+    /* count is left over, selecting threads can take it */
+    else if (SelectWaiters > 0) {
+        WakeSelectors(s);
     }
 
     /* end critical section & enable interrupts */
     EndCriticalSection(state);
 }
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_IsSelecting
+ * INPUTS: (tcb_t *) thread
+ * OUTPUTS: (bool) selecting
+ * Whether thread is blocked in G8RTOS_Select, so it
+ * holds no semaphore count a timeout could give back
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+bool G8RTOS_IsSelecting(tcb_t *thread)
+{
+    return thread->blocked == &SelectSentinel;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_CancelSelect
+ * INPUTS: (tcb_t *) thread
+ * OUTPUTS: void
+ * Takes a thread that is killed out of G8RTOS_Select,
+ * it never resumes to leave it itself
+ *  - Does nothing if thread is not selecting
+ *  - Must be called inside a critical section
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_CancelSelect(tcb_t *thread)
+{
+    if (thread->blocked != &SelectSentinel)
+        return;
+
+    /* the thread will not decrement SelectWaiters after its yield, every later signal would walk the TCBs */
+    SelectWaiters--;
+    thread->blocked = 0;
+    thread->selectSet = 0;
+    thread->selectCount = 0;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_Select
+ * INPUTS: (semaphore_t * const *) set, (uint32_t) count,
+ *         (uint32_t) timeoutMS
+ * OUTPUTS: (uint32_t) ready
+ * Waits at most timeoutMS until any of count (at most
+ * 32) semaphores is available ((*s) > 0)
+ *  - Bit i of ready is set if set[i] is available, 0
+ *    means the timeout expired
+ *  - Does not take any semaphore, the caller takes the
+ *    ready ones without blocking (e.g. tryReadFIFO)
+ *  - May return 0 early if another thread took the
+ *    semaphore first, callers select in a loop
+ *  - FIFOs and mailboxes are selected through their
+ *    currentSize and messages semaphores
+ *  - A timeout of 0 polls and is safe from ISRs
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_Select(semaphore_t * const *set, uint32_t count, uint32_t timeoutMS)
+{
+    /* a ready mask only holds 32 semaphores */
+    if (count > 32)
+        count = 32;
+
+    /* start critical section & disable interrupts */
+    int32_t state = StartCriticalSection();
+
+    /* return right away if something is ready or polling */
+    uint32_t ready = ReadyMask(set, count);
+    if (ready || timeoutMS == 0) {
+        /* end critical section & enable interrupts */
+        EndCriticalSection(state);
+
+        return ready;
+    }
+
+    /* block thread on the select sentinel until a semaphore in set is signaled */
+    CurrentlyRunningThread->selectSet = set;
+    CurrentlyRunningThread->selectCount = count;
+    CurrentlyRunningThread->blocked = &SelectSentinel;
+    CurrentlyRunningThread->timedOut = false;
+    SelectWaiters++;
+
+    /* sleep it until the timeout as well */
+    if (timeoutMS != G8RTOS_WAIT_FOREVER) {
+        CurrentlyRunningThread->sleepCount = timeoutMS + SystemTime;
+        CurrentlyRunningThread->asleep = true;
+    }
+
+    /* end critical section & enable interrupts */
+    EndCriticalSection(state);
+
+    /* call PendSV and flush pipelines so the switch happens before returning */
+    G8RTOS_PortYield();
+    __DSB();
+    __ISB();
+
+    /* start critical section & disable interrupts */
+    state = StartCriticalSection();
+
+    /* thread resumes once woken or timed out */
+    SelectWaiters--;
+    CurrentlyRunningThread->selectSet = 0;
+    CurrentlyRunningThread->selectCount = 0;
+    ready = ReadyMask(set, count);
+
+    /* end critical section & enable interrupts */
+    EndCriticalSection(state);
+
+    return ready;
+}
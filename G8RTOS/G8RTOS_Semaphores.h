@@ -10,6 +10,24 @@
 #ifndef G8RTOS_SEMAPHORES_H_
 #define G8RTOS_SEMAPHORES_H_
 
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                        DEFINES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* timeout that never expires */
+#define G8RTOS_WAIT_FOREVER UINT32_MAX
+
 /*
  * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
  *                  DATA TYPE DEFINITIONS
@@ -23,6 +41,25 @@
  */
 typedef int32_t semaphore_t;
 
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Semaphore configuration typedef
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef struct semaphoreConfig semaphoreConfig_t;
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Semaphore configuration
+ * One entry of a static semaphore table passed to
+ * G8RTOS_InitSemaphores
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+struct semaphoreConfig {
+    semaphore_t *semaphore;
+    int32_t value;
+};
+
 /*
  * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
  *                    PUBLIC FUNCTIONS
@@ -39,6 +76,17 @@ typedef int32_t semaphore_t;
  */
 void G8RTOS_InitSemaphore(semaphore_t *s, int32_t value);
 
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_InitSemaphores
+ * INPUTS: (const semaphoreConfig_t *) semaphores,
+ *         (uint32_t) count
+ * OUTPUTS: void
+ * Initializes every semaphore of a static table
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_InitSemaphores(const semaphoreConfig_t *semaphores, uint32_t count);
+
 /*
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  * G8RTOS_WaitSemaphore
@@ -53,6 +101,38 @@ void G8RTOS_InitSemaphore(semaphore_t *s, int32_t value);
  */
 void G8RTOS_WaitSemaphore(semaphore_t *s);
 
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_TryWaitSemaphore
+ * INPUTS: (semaphore_t *) s
+ * OUTPUTS: (bool) acquired
+ * Takes a semaphore only if it is available ((*s) > 0)
+ *  - Decrements semaphore and returns true when available
+ *  - Returns false without blocking otherwise
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+bool G8RTOS_TryWaitSemaphore(semaphore_t *s);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_WaitSemaphoreTimeout
+ * INPUTS: (semaphore_t *) s, (uint32_t) timeoutMS
+ * OUTPUTS: (bool) acquired
+ * Waits at most timeoutMS for a semaphore to be
+ * available ((*s) > 0)
+ *  - Decrements semaphore and returns true when available
+ *  - Blocks and sleeps the thread if unavailable, the
+ *    SysTick handler gives the semaphore back and
+ *    returns false once the timeout expires
+ *  - A timeout of 0 never blocks, G8RTOS_WAIT_FOREVER
+ *    never times out
+ *  - Threads only, never call from an ISR
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+bool G8RTOS_WaitSemaphoreTimeout(semaphore_t *s, uint32_t timeoutMS);
+
 /*
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  * G8RTOS_SignalSemaphore
@@ -61,9 +141,32 @@ void G8RTOS_WaitSemaphore(semaphore_t *s);
  * Signals the completion of the usage of a semaphore
  *  - Increments semaphore by 1
  *  - Unblocks first thread with the blocked semaphore
+ *  - Otherwise wakes threads selecting on it
  *  - CRITICAL SECTION
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  */
 void G8RTOS_SignalSemaphore(semaphore_t *s);
 
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_Select
+ * INPUTS: (semaphore_t * const *) set, (uint32_t) count,
+ *         (uint32_t) timeoutMS
+ * OUTPUTS: (uint32_t) ready
+ * Waits at most timeoutMS until any of count (at most
+ * 32) semaphores is available ((*s) > 0)
+ *  - Bit i of ready is set if set[i] is available, 0
+ *    means the timeout expired
+ *  - Does not take any semaphore, the caller takes the
+ *    ready ones without blocking (e.g. tryReadFIFO)
+ *  - May return 0 early if another thread took the
+ *    semaphore first, callers select in a loop
+ *  - FIFOs and mailboxes are selected through their
+ *    currentSize and messages semaphores
+ *  - A timeout of 0 polls and is safe from ISRs
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_Select(semaphore_t * const *set, uint32_t count, uint32_t timeoutMS);
+
 #endif /* G8RTOS_SEMAPHORES_H_ */
@@ -0,0 +1,143 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/16/2020                                                |
+ * | SUMMARY: G8RTOS_Seqlock.c                                       |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "msp.h"
+#include "G8RTOS_Seqlock.h"
+#include "G8RTOS_CriticalSection.h"
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_InitSeqlock
+ * INPUTS: (seqlock_t *) lock
+ * OUTPUTS: void
+ * Initializes a seqlock with no writer active
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_InitSeqlock(seqlock_t *lock)
+{
+    lock->sequence = 0;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_SeqlockWriteBegin
+ * INPUTS: (seqlock_t *) lock
+ * OUTPUTS: (int32_t) status
+ * Starts an update of the protected data
+ *  - Makes sequence odd
+ *  - Writers are serialized by a critical section that
+ *    lasts until G8RTOS_SeqlockWriteEnd, keep updates
+ *    short
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int32_t G8RTOS_SeqlockWriteBegin(seqlock_t *lock)
+{
+    /* start critical section & disable interrupts */
+    int32_t status = StartCriticalSection();
+
+    /* mark update in progress before touching the data */
+    lock->sequence++;
+    __DMB();
+
+    return status;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_SeqlockWriteEnd
+ * INPUTS: (seqlock_t *) lock, (int32_t) status
+ * OUTPUTS: void
+ * Publishes an update of the protected data
+ *  - Makes sequence even again
+ *  - status is the value G8RTOS_SeqlockWriteBegin
+ *    returned
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_SeqlockWriteEnd(seqlock_t *lock, int32_t status)
+{
+    /* data must be written before the update is marked done */
+    __DMB();
+    lock->sequence++;
+
+    /* end critical section and enable interrupts */
+    EndCriticalSection(status);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_SeqlockReadBegin
+ * INPUTS: (seqlock_t *) lock
+ * OUTPUTS: (uint32_t) sequence
+ * Starts reading the protected data
+ *  - Pass the returned sequence to
+ *    G8RTOS_SeqlockReadRetry once done reading
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_SeqlockReadBegin(seqlock_t *lock)
+{
+    /* an odd sequence never matches, so a read during an update retries */
+    uint32_t sequence = lock->sequence & ~1u;
+
+    /* sequence must be read before the data */
+    __DMB();
+
+    return sequence;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_SeqlockReadRetry
+ * INPUTS: (seqlock_t *) lock, (uint32_t) sequence
+ * OUTPUTS: (bool) retry
+ * Returns true if a writer ran while reading, the data
+ * read since G8RTOS_SeqlockReadBegin may be torn
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+bool G8RTOS_SeqlockReadRetry(seqlock_t *lock, uint32_t sequence)
+{
+    /* data must be read before the sequence is checked again */
+    __DMB();
+
+    return lock->sequence != sequence;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_SeqlockRead
+ * INPUTS: (seqlock_t *) lock, (void *) snapshot,
+ *         (const void *) data, (uint32_t) size
+ * OUTPUTS: void
+ * Copies size bytes of data into snapshot, retrying
+ * until no writer ran during the copy
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_SeqlockRead(seqlock_t *lock, void *snapshot, const void *data, uint32_t size)
+{
+    uint32_t sequence;
+
+    do {
+        sequence = G8RTOS_SeqlockReadBegin(lock);
+        memcpy(snapshot, data, size);
+    } while (G8RTOS_SeqlockReadRetry(lock, sequence));
+}
@@ -0,0 +1,126 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/16/2020                                                |
+ * | SUMMARY: G8RTOS_Seqlock.h                                       |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifndef G8RTOS_SEQLOCK_H_
+#define G8RTOS_SEQLOCK_H_
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                  DATA TYPE DEFINITIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Seqlock typedef
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef struct seqlock seqlock_t;
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Seqlock
+ * sequence is odd while a writer updates the protected
+ * data. Readers copy the data and retry if sequence
+ * changed meanwhile, they never block a writer
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+struct seqlock {
+    volatile uint32_t sequence;
+};
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_InitSeqlock
+ * INPUTS: (seqlock_t *) lock
+ * OUTPUTS: void
+ * Initializes a seqlock with no writer active
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_InitSeqlock(seqlock_t *lock);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_SeqlockWriteBegin
+ * INPUTS: (seqlock_t *) lock
+ * OUTPUTS: (int32_t) status
+ * Starts an update of the protected data
+ *  - Makes sequence odd
+ *  - Writers are serialized by a critical section that
+ *    lasts until G8RTOS_SeqlockWriteEnd, keep updates
+ *    short
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int32_t G8RTOS_SeqlockWriteBegin(seqlock_t *lock);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_SeqlockWriteEnd
+ * INPUTS: (seqlock_t *) lock, (int32_t) status
+ * OUTPUTS: void
+ * Publishes an update of the protected data
+ *  - Makes sequence even again
+ *  - status is the value G8RTOS_SeqlockWriteBegin
+ *    returned
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_SeqlockWriteEnd(seqlock_t *lock, int32_t status);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_SeqlockReadBegin
+ * INPUTS: (seqlock_t *) lock
+ * OUTPUTS: (uint32_t) sequence
+ * Starts reading the protected data
+ *  - Pass the returned sequence to
+ *    G8RTOS_SeqlockReadRetry once done reading
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_SeqlockReadBegin(seqlock_t *lock);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_SeqlockReadRetry
+ * INPUTS: (seqlock_t *) lock, (uint32_t) sequence
+ * OUTPUTS: (bool) retry
+ * Returns true if a writer ran while reading, the data
+ * read since G8RTOS_SeqlockReadBegin may be torn
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+bool G8RTOS_SeqlockReadRetry(seqlock_t *lock, uint32_t sequence);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_SeqlockRead
+ * INPUTS: (seqlock_t *) lock, (void *) snapshot,
+ *         (const void *) data, (uint32_t) size
+ * OUTPUTS: void
+ * Copies size bytes of data into snapshot, retrying
+ * until no writer ran during the copy
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_SeqlockRead(seqlock_t *lock, void *snapshot, const void *data, uint32_t size);
+
+#endif /* G8RTOS_SEQLOCK_H_ */
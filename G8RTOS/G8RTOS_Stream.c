@@ -0,0 +1,234 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/15/2020                                                |
+ * | SUMMARY: G8RTOS_Stream.c                                        |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "msp.h"
+#include "G8RTOS_Stream.h"
+#include "G8RTOS_Scheduler.h"
+#include "G8RTOS_CriticalSection.h"
+#include "G8RTOS_Config.h"
+
+#if G8RTOS_USE_IPC
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PRIVATE FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * ReadBytes
+ * INPUTS: (stream_t *) stream, (uint8_t *) buf,
+ *         (uint32_t) maxLen
+ * OUTPUTS: (uint32_t) bytes read
+ * Moves up to maxLen buffered bytes into buf
+ *  - Copies at most two chunks around the wrap
+ *  - Must be called inside a critical section
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static uint32_t ReadBytes(stream_t *stream, uint8_t *buf, uint32_t maxLen)
+{
+    uint32_t n = (stream->count < maxLen) ? stream->count : maxLen;
+
+    /* copy up to the end of the buffer, then from the start */
+    uint32_t first = stream->size - stream->head;
+    if (first > n)
+        first = n;
+    memcpy(buf, &stream->buffer[stream->head], first);
+    memcpy(buf + first, stream->buffer, n - first);
+
+    /* advance head (wrap if necessary) */
+    stream->head += n;
+    if (stream->head >= stream->size)
+        stream->head -= stream->size;
+    stream->count -= n;
+
+    return n;
+}
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_InitStream
+ * INPUTS: (stream_t *) stream, (uint8_t *) storage,
+ *         (uint32_t) size, (uint32_t) triggerLevel
+ * OUTPUTS: (int) error
+ * Initializes an empty stream over size bytes of
+ * static storage
+ *  - triggerLevel must be between 1 and size
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_InitStream(stream_t *stream, uint8_t *storage, uint32_t size, uint32_t triggerLevel)
+{
+    /* return error code if trigger level can never be reached */
+    if (size == 0 || triggerLevel == 0 || triggerLevel > size)
+        return -1;
+
+    /* assign default values to stream properties */
+    stream->buffer = storage;
+    stream->size = size;
+    stream->head = 0;
+    stream->count = 0;
+    stream->triggerLevel = triggerLevel;
+    stream->readerWants = triggerLevel;
+    stream->lostBytes = 0;
+    stream->readerWaiting = false;
+
+    /* nothing buffered yet */
+    G8RTOS_InitSemaphore(&stream->dataReady, 0);
+
+    /* return error code */
+    return 1;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_SetStreamTrigger
+ * INPUTS: (stream_t *) stream, (uint32_t) triggerLevel
+ * OUTPUTS: (int) error
+ * Changes the bytes a reader waits for
+ *  - triggerLevel must be between 1 and size
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_SetStreamTrigger(stream_t *stream, uint32_t triggerLevel)
+{
+    /* return error code if trigger level can never be reached */
+    if (triggerLevel == 0 || triggerLevel > stream->size)
+        return -1;
+
+    stream->triggerLevel = triggerLevel;
+
+    /* return error code */
+    return 1;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_StreamSend
+ * INPUTS: (stream_t *) stream, (const uint8_t *) buf,
+ *         (uint32_t) len
+ * OUTPUTS: (uint32_t) bytes sent
+ * Appends up to len bytes without blocking
+ *  - Bytes that do not fit are counted as lost
+ *  - Wakes the reader once its trigger level is reached
+ *  - Safe from ISRs
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_StreamSend(stream_t *stream, const uint8_t *buf, uint32_t len)
+{
+    /* start critical section & disable interrupts */
+    int32_t status = StartCriticalSection();
+
+    /* send as many bytes as fit, the rest is lost */
+    uint32_t n = stream->size - stream->count;
+    if (n > len)
+        n = len;
+    stream->lostBytes += len - n;
+
+    /* tail is count bytes past head */
+    uint32_t tail = stream->head + stream->count;
+    if (tail >= stream->size)
+        tail -= stream->size;
+
+    /* copy up to the end of the buffer, then from the start */
+    uint32_t first = stream->size - tail;
+    if (first > n)
+        first = n;
+    memcpy(&stream->buffer[tail], buf, first);
+    memcpy(stream->buffer, buf + first, n - first);
+    stream->count += n;
+
+    /* wake the reader only once it has enough to read */
+    if (stream->readerWaiting && stream->count >= stream->readerWants) {
+        stream->readerWaiting = false;
+        G8RTOS_SignalSemaphore(&stream->dataReady);
+    }
+
+    /* end critical section and enable interrupts */
+    EndCriticalSection(status);
+
+    return n;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_StreamReceive
+ * INPUTS: (stream_t *) stream, (uint8_t *) buf,
+ *         (uint32_t) maxLen, (uint32_t) timeoutMS
+ * OUTPUTS: (uint32_t) bytes received
+ * Waits at most timeoutMS for the trigger level (or
+ * maxLen if smaller) to be buffered, then moves up to
+ * maxLen bytes into buf
+ *  - Returns what is buffered, possibly 0, on timeout
+ *  - A timeout of 0 never blocks and is safe from ISRs
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_StreamReceive(stream_t *stream, uint8_t *buf, uint32_t maxLen, uint32_t timeoutMS)
+{
+    uint32_t deadline = SystemTime + timeoutMS;
+    uint32_t wants = (stream->triggerLevel < maxLen) ? stream->triggerLevel : maxLen;
+    uint32_t n;
+
+    while (1) {
+        /* start critical section & disable interrupts */
+        int32_t status = StartCriticalSection();
+
+        /* read once enough is buffered, otherwise announce the wait */
+        bool ready = stream->count >= wants;
+        if (ready) {
+            n = ReadBytes(stream, buf, maxLen);
+        }
+        else {
+            stream->readerWants = wants;
+            stream->readerWaiting = (timeoutMS != 0);
+        }
+
+        /* end critical section and enable interrupts */
+        EndCriticalSection(status);
+
+        if (ready)
+            return n;
+
+        /* give up once the deadline has passed */
+        uint32_t remaining = (timeoutMS == G8RTOS_WAIT_FOREVER) ? G8RTOS_WAIT_FOREVER : deadline - SystemTime;
+        if (remaining == 0 || remaining > timeoutMS ||
+            !G8RTOS_WaitSemaphoreTimeout(&stream->dataReady, remaining))
+            break;
+
+        /* a stale signal may wake the reader early, the loop checks again */
+    }
+
+    /* start critical section & disable interrupts */
+    int32_t status = StartCriticalSection();
+
+    /* timed out, hand over whatever is buffered */
+    stream->readerWaiting = false;
+    n = ReadBytes(stream, buf, maxLen);
+
+    /* end critical section and enable interrupts */
+    EndCriticalSection(status);
+
+    return n;
+}
+
+#endif /* G8RTOS_USE_IPC */
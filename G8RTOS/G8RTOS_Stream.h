@@ -0,0 +1,117 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/15/2020                                                |
+ * | SUMMARY: G8RTOS_Stream.h                                        |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifndef G8RTOS_STREAM_H_
+#define G8RTOS_STREAM_H_
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "G8RTOS_Semaphores.h"
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                  DATA TYPE DEFINITIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Stream typedef
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef struct stream stream_t;
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Stream
+ * Byte ring for one reader. A waiting reader is only
+ * woken once readerWants bytes are buffered, which is
+ * the trigger level or less if the reader asked for
+ * less. lostBytes counts bytes sent to a full stream
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+struct stream {
+    uint8_t *buffer;
+    uint32_t size;
+    uint32_t head;
+    uint32_t count;
+    uint32_t triggerLevel;
+    uint32_t readerWants;
+    uint32_t lostBytes;
+    bool readerWaiting;
+    semaphore_t dataReady;
+};
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_InitStream
+ * INPUTS: (stream_t *) stream, (uint8_t *) storage,
+ *         (uint32_t) size, (uint32_t) triggerLevel
+ * OUTPUTS: (int) error
+ * Initializes an empty stream over size bytes of
+ * static storage
+ *  - triggerLevel must be between 1 and size
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_InitStream(stream_t *stream, uint8_t *storage, uint32_t size, uint32_t triggerLevel);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_SetStreamTrigger
+ * INPUTS: (stream_t *) stream, (uint32_t) triggerLevel
+ * OUTPUTS: (int) error
+ * Changes the bytes a reader waits for
+ *  - triggerLevel must be between 1 and size
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_SetStreamTrigger(stream_t *stream, uint32_t triggerLevel);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_StreamSend
+ * INPUTS: (stream_t *) stream, (const uint8_t *) buf,
+ *         (uint32_t) len
+ * OUTPUTS: (uint32_t) bytes sent
+ * Appends up to len bytes without blocking
+ *  - Bytes that do not fit are counted as lost
+ *  - Wakes the reader once its trigger level is reached
+ *  - Safe from ISRs
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_StreamSend(stream_t *stream, const uint8_t *buf, uint32_t len);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_StreamReceive
+ * INPUTS: (stream_t *) stream, (uint8_t *) buf,
+ *         (uint32_t) maxLen, (uint32_t) timeoutMS
+ * OUTPUTS: (uint32_t) bytes received
+ * Waits at most timeoutMS for the trigger level (or
+ * maxLen if smaller) to be buffered, then moves up to
+ * maxLen bytes into buf
+ *  - Returns what is buffered, possibly 0, on timeout
+ *  - A timeout of 0 never blocks and is safe from ISRs
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t G8RTOS_StreamReceive(stream_t *stream, uint8_t *buf, uint32_t maxLen, uint32_t timeoutMS);
+
+#endif /* G8RTOS_STREAM_H_ */
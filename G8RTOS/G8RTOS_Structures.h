@@ -18,14 +18,6 @@
 
 #include "G8RTOS.h"
 
-/*
- * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
- *                        DEFINES
- * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
- */
-
-#define MAX_NAME_LENGTH 16
-
 /*
  * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
  *               DATA STRUCTURE DEFINITIONS
@@ -44,7 +36,14 @@ typedef struct tcb tcb_t;
  * Thread Control Block
  * The Thread Control Block holds information about the
  * thread such as the stack pointer, priority level,
- * blocked status, next and previous TCB pointers
+ * blocked status, next and previous TCB pointers.
+ * runCount counts how often the scheduler picked it.
+ * EDF threads run jobs every period that must finish
+ * relativeDeadline after their release.
+ * sliceRemaining is the ms left of the time slice and
+ * sliceExpiries counts slices used up while running.
+ * Threads with a budget may run budgetRemaining more ms
+ * until replenishTime, throttled ones used it up
  * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
  */
 struct tcb {
@@ -52,12 +51,40 @@ struct tcb {
     struct tcb *nextTCB;
     struct tcb *previousTCB;
     semaphore_t *blocked;
+    semaphore_t * const *selectSet;
+    uint32_t selectCount;
     uint32_t sleepCount;
     bool asleep;
+    bool timedOut;
     uint8_t priority;
     bool alive;
     threadID_t threadID;
     char threadName[MAX_NAME_LENGTH];
+#if G8RTOS_USE_STATS
+    uint32_t runCount;
+#endif
+#if G8RTOS_USE_EDF
+    bool edf;
+    uint32_t period;
+    uint32_t relativeDeadline;
+    uint32_t release;
+    uint32_t absoluteDeadline;
+    uint32_t deadlineMisses;
+#endif
+#if G8RTOS_USE_TIME_SLICE
+    uint8_t sliceRemaining;
+    uint32_t sliceExpiries;
+#endif
+#if G8RTOS_USE_BUDGET
+    uint32_t budget;
+    uint32_t budgetRemaining;
+    uint32_t replenishPeriod;
+    uint32_t replenishTime;
+    budgetPolicy_t budgetPolicy;
+    uint8_t basePriority;
+    bool throttled;
+    uint32_t overruns;
+#endif
 };
 
 /*
@@ -94,4 +121,34 @@ struct ptcb {
 /* pointer to active thread */
 tcb_t * CurrentlyRunningThread;
 
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    KERNEL FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_IsSelecting
+ * INPUTS: (tcb_t *) thread
+ * OUTPUTS: (bool) selecting
+ * Whether thread is blocked in G8RTOS_Select, so it
+ * holds no semaphore count a timeout could give back
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+bool G8RTOS_IsSelecting(tcb_t *thread);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_CancelSelect
+ * INPUTS: (tcb_t *) thread
+ * OUTPUTS: void
+ * Takes a thread that is killed out of G8RTOS_Select,
+ * it never resumes to leave it itself
+ *  - Does nothing if thread is not selecting
+ *  - Must be called inside a critical section
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_CancelSelect(tcb_t *thread);
+
 #endif /* G8RTOS_STRUCTURES_H_ */
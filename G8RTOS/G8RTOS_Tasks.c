@@ -0,0 +1,191 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/04/2020                                                |
+ * | SUMMARY: G8RTOS_Tasks.c                                         |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "G8RTOS_Tasks.h"
+#include "G8RTOS_CriticalSection.h"
+#include "G8RTOS_Config.h"
+
+#if G8RTOS_USE_TASKS
+
+/* the task scheduler selects on every awaited semaphore plus TasksAdded */
+#if MAX_TASKS > 31
+#error "G8RTOS_Select waits on at most 32 semaphores, MAX_TASKS must be below 32"
+#endif
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                  DATA STRUCTURES USED
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Task Control Blocks
+ * An array of task control blocks, all tasks share the
+ * stack of the task scheduler thread
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static task_t tasks[MAX_TASKS];
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PRIVATE VARIABLES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* current number of tasks in the task scheduler */
+static uint32_t NumberOfTasks;
+
+/* signaled by G8RTOS_AddTask so the task scheduler runs the new task */
+static semaphore_t TasksAdded;
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_AddTask
+ * INPUTS: (taskStatus_t)(* taskToAdd)(task_t *)
+ * OUTPUTS: (int) error
+ * Adds a stackless task to the task scheduler
+ *  - Returns error code if task limit reached
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_AddTask(taskStatus_t (*taskToAdd)(task_t *task))
+{
+    /* start critical section & disable interrupts */
+    int32_t status = StartCriticalSection();
+
+    /* return error code and end critical section if task limit reached */
+    if (NumberOfTasks == MAX_TASKS) {
+        EndCriticalSection(status);
+        return THREAD_LIMIT_REACHED;
+    }
+
+    /* task offset */
+    int i = 0;
+
+    /* search for dead task */
+    while (tasks[i].alive)
+        i++;
+
+    /* assign default values to task properties */
+    tasks[i].handler = taskToAdd;
+    tasks[i].wakeTime = 0;
+    tasks[i].awaited = 0;
+    tasks[i].lc = 0;
+    tasks[i].asleep = false;
+    tasks[i].alive = true;
+
+    /* increment number of tasks */
+    NumberOfTasks++;
+
+    /* end critical section and enable interrupts */
+    EndCriticalSection(status);
+
+    /* wake the task scheduler thread */
+    G8RTOS_SignalSemaphore(&TasksAdded);
+
+    /* return error code */
+    return NO_ERROR;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_TaskScheduler
+ * INPUTS: void
+ * OUTPUTS: void
+ * G8RTOS thread that multiplexes every stackless task
+ *  - Runs each task that is alive and not asleep
+ *  - Blocks until an awaited semaphore is signaled, a
+ *    task is added or the earliest task wakes up, at
+ *    most TASK_POLL_PERIOD if a task waits on a
+ *    condition or yielded
+ *  - Add with G8RTOS_AddThread
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_TaskScheduler()
+{
+    semaphore_t *awaited[MAX_TASKS + 1];
+
+    while (1) {
+        /* tasks added so far are run below */
+        while (G8RTOS_TryWaitSemaphore(&TasksAdded));
+
+        /* time until the earliest sleeping task wakes up */
+        uint32_t sleepDuration = UINT32_MAX;
+
+        /* semaphores to block on, a new task wakes the scheduler as well */
+        uint32_t numberAwaited = 0;
+        awaited[numberAwaited++] = &TasksAdded;
+
+        /* run every task that is ready */
+        for (int i = 0; i < MAX_TASKS; i++) {
+            task_t * task = &tasks[i];
+
+            if (!task->alive)
+                continue;
+
+            /* skip sleeping tasks, remembering the earliest wake up */
+            if (task->asleep) {
+                int32_t remaining = (int32_t)(task->wakeTime - SystemTime);
+
+                if (remaining > 0) {
+                    if ((uint32_t)remaining < sleepDuration)
+                        sleepDuration = remaining;
+                    continue;
+                }
+
+                task->asleep = false;
+            }
+
+            /* resume task from its local continuation */
+            taskStatus_t taskStatus = (*task->handler)(task);
+
+            /* remove tasks that ran to completion */
+            if (taskStatus == TASK_EXITED) {
+                int32_t status = StartCriticalSection();
+                task->alive = false;
+                NumberOfTasks--;
+                EndCriticalSection(status);
+            }
+            else if (!task->asleep) {
+                /* tasks awaiting a semaphore wake the scheduler when it is signaled */
+                if (task->awaited && taskStatus == TASK_WAITING)
+                    awaited[numberAwaited++] = task->awaited;
+                /* tasks waiting on a condition or yielding are polled again soon */
+                else if (sleepDuration > TASK_POLL_PERIOD)
+                    sleepDuration = TASK_POLL_PERIOD;
+            }
+            /* newly sleeping tasks bound the sleep duration as well */
+            else if (task->wakeTime - SystemTime < sleepDuration)
+                sleepDuration = task->wakeTime - SystemTime;
+        }
+
+        /* never sleep for 0 ms, the wake up would be missed */
+        if (sleepDuration == 0)
+            sleepDuration = 1;
+
+        /* block until a semaphore is signaled or the earliest task wakes up, UINT32_MAX waits forever */
+        G8RTOS_Select(awaited, numberAwaited, sleepDuration);
+    }
+}
+
+#endif /* G8RTOS_USE_TASKS */
@@ -0,0 +1,184 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/04/2020                                                |
+ * | SUMMARY: G8RTOS_Tasks.h                                         |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifndef G8RTOS_TASKS_H_
+#define G8RTOS_TASKS_H_
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "G8RTOS_Config.h"
+#include "G8RTOS_Semaphores.h"
+#include "G8RTOS_Scheduler.h"
+#include "G8RTOS_IPC.h"
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                  DATA TYPE DEFINITIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Task status typedef
+ * Returned by a task handler every time it gives the
+ * CPU back to the task scheduler
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef enum {
+    TASK_WAITING = 0,
+    TASK_YIELDED = 1,
+    TASK_EXITED = 2
+} taskStatus_t;
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Task Control Block typedef
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef struct task task_t;
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Task Control Block
+ * A stackless task only keeps the line it is suspended
+ * at (local continuation), its wake up time and the
+ * semaphore it awaits. Every task runs on the stack of
+ * the task scheduler thread
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+struct task {
+    taskStatus_t (*handler)(task_t *task);
+    uint32_t wakeTime;
+    semaphore_t *awaited;
+    uint16_t lc;
+    bool asleep;
+    bool alive;
+};
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    TASK MACROS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *
+ * A task handler is a function of the form
+ *
+ *     taskStatus_t MyTask(task_t *task)
+ *     {
+ *         TASK_BEGIN(task);
+ *         while (1) {
+ *             ...
+ *             TASK_AWAIT_SLEEP(task, 10);
+ *         }
+ *         TASK_END(task);
+ *     }
+ *
+ * Local variables are NOT preserved across an await,
+ * declare them static if they must survive one. Only
+ * one await may appear per source line and switch
+ * statements can not wrap an await.
+ *
+ * Sleeps, semaphores and FIFOs cost nothing while a
+ * task waits: the task scheduler thread blocks in
+ * G8RTOS_Select until a semaphore is signaled or a
+ * sleep ends. TASK_WAIT_UNTIL and TASK_YIELD can not be
+ * waited on, while any task is in one the scheduler
+ * thread wakes every TASK_POLL_PERIOD ms to re-check
+ * it, up to TASK_POLL_PERIOD ms late and 1000 /
+ * TASK_POLL_PERIOD context switches a second.
+ */
+
+/* opens the body of a task handler */
+#define TASK_BEGIN(task)    switch ((task)->lc) { case 0:
+
+/* closes the body of a task handler, the task is removed */
+#define TASK_END(task)      } (task)->lc = 0; return TASK_EXITED
+
+/* suspends the task until cond is true, cond is re-evaluated every TASK_POLL_PERIOD */
+#define TASK_WAIT_UNTIL(task, cond)         \
+    do {                                    \
+        (task)->lc = __LINE__;              \
+        case __LINE__:                      \
+        if (!(cond))                        \
+            return TASK_WAITING;            \
+    } while (0)
+
+/* gives the CPU to the other tasks once */
+#define TASK_YIELD(task)                    \
+    do {                                    \
+        (task)->lc = __LINE__;              \
+        return TASK_YIELDED;                \
+        case __LINE__:;                     \
+    } while (0)
+
+/* suspends the task for durationMS, the task is not polled while asleep */
+#define TASK_AWAIT_SLEEP(task, durationMS)              \
+    do {                                                \
+        (task)->wakeTime = SystemTime + (durationMS);   \
+        (task)->asleep = true;                          \
+        (task)->lc = __LINE__;                          \
+        return TASK_WAITING;                            \
+        case __LINE__:;                                 \
+    } while (0)
+
+/* suspends the task until the semaphore is taken, the task scheduler thread blocks on it meanwhile */
+#define TASK_AWAIT_SEMAPHORE(task, s)                       \
+    do {                                                    \
+        (task)->awaited = (s);                              \
+        TASK_WAIT_UNTIL(task, G8RTOS_TryWaitSemaphore(s));  \
+        (task)->awaited = 0;                                \
+    } while (0)
+
+/* suspends the task until one element is read from FIFO into *data, the task scheduler thread blocks on it meanwhile */
+#define TASK_AWAIT_FIFO(task, FIFO, data)                   \
+    do {                                                    \
+        (task)->awaited = FIFOSemaphore(FIFO);              \
+        TASK_WAIT_UNTIL(task, tryReadFIFO(FIFO, data) > 0); \
+        (task)->awaited = 0;                                \
+    } while (0)
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_AddTask
+ * INPUTS: (taskStatus_t)(* taskToAdd)(task_t *)
+ * OUTPUTS: (int) error
+ * Adds a stackless task to the task scheduler
+ *  - Returns error code if task limit reached
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_AddTask(taskStatus_t (*taskToAdd)(task_t *task));
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_TaskScheduler
+ * INPUTS: void
+ * OUTPUTS: void
+ * G8RTOS thread that multiplexes every stackless task
+ *  - Runs each task that is alive and not asleep
+ *  - Blocks until an awaited semaphore is signaled, a
+ *    task is added or the earliest task wakes up, at
+ *    most TASK_POLL_PERIOD if a task waits on a
+ *    condition or yielded
+ *  - Add with G8RTOS_AddThread
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_TaskScheduler();
+
+#endif /* G8RTOS_TASKS_H_ */
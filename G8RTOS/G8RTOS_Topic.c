@@ -0,0 +1,224 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/14/2020                                                |
+ * | SUMMARY: G8RTOS_Topic.c                                         |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "msp.h"
+#include "G8RTOS_Topic.h"
+#include "G8RTOS_Scheduler.h"
+#include "G8RTOS_CriticalSection.h"
+#include "G8RTOS_Config.h"
+
+#if G8RTOS_USE_IPC
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PRIVATE FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * TakeSample
+ * INPUTS: (subscriber_t *) sub, (void *) sample
+ * OUTPUTS: (bool) taken
+ * Copies the oldest queued sample of sub, if any
+ *  - Samples older than the newest depth delivered ones
+ *    are skipped and counted as lost
+ *  - Must be called inside a critical section
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static bool TakeSample(subscriber_t *sub, void *sample)
+{
+    topic_t *topic = sub->topic;
+
+    /* samples published since subscribing, delivered ones are multiples of decimation */
+    uint32_t seen = topic->published - sub->start;
+    uint32_t delivered = (seen + sub->decimation - 1) / sub->decimation;
+
+    /* nothing new */
+    if (delivered == sub->taken)
+        return false;
+
+    /* only the newest depth samples are queued */
+    if (delivered - sub->taken > sub->depth) {
+        sub->lost += delivered - sub->taken - sub->depth;
+        sub->taken = delivered - sub->depth;
+    }
+
+    /* copy sample out of the topic ring */
+    uint32_t index = (sub->start + sub->taken * sub->decimation) % topic->depth;
+    memcpy(sample, &topic->samples[index * topic->sampleSize], topic->sampleSize);
+    sub->taken++;
+
+    return true;
+}
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_InitTopic
+ * INPUTS: (topic_t *) topic, (uint32_t *) storage,
+ *         (uint32_t) sampleSize, (uint32_t) depth
+ * OUTPUTS: (int) error
+ * Initializes a topic with no samples and no subscribers
+ *  - storage must hold TOPIC_STORAGE_WORDS(sampleSize,
+ *    depth) words
+ *  - depth bounds depth * decimation of every subscriber
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_InitTopic(topic_t *topic, uint32_t *storage, uint32_t sampleSize, uint32_t depth)
+{
+    /* return error code if topic is empty */
+    if (sampleSize == 0 || depth == 0)
+        return -1;
+
+    /* assign default values to topic properties, samples are word aligned */
+    topic->samples = (uint8_t *)storage;
+    topic->sampleSize = (sampleSize + 3) & ~3;
+    topic->depth = depth;
+    topic->published = 0;
+    topic->subscribers = 0;
+
+    /* return error code */
+    return 1;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_Subscribe
+ * INPUTS: (topic_t *) topic, (subscriber_t *) sub,
+ *         (uint32_t) depth, (uint32_t) decimation
+ * OUTPUTS: (int) error
+ * Subscribes sub to samples published from now on
+ *  - Returns -1 if the topic does not keep enough
+ *    samples for depth * decimation
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_Subscribe(topic_t *topic, subscriber_t *sub, uint32_t depth, uint32_t decimation)
+{
+    /* return error code if the topic would overwrite queued samples */
+    if (depth == 0 || decimation == 0 || depth * decimation > topic->depth)
+        return -1;
+
+    /* assign default values to subscriber properties */
+    sub->topic = topic;
+    sub->depth = depth;
+    sub->decimation = decimation;
+    sub->taken = 0;
+    sub->lost = 0;
+    sub->waiting = false;
+    G8RTOS_InitSemaphore(&sub->notify, 0);
+
+    /* start critical section & disable interrupts */
+    int32_t status = StartCriticalSection();
+
+    /* first delivered sample is the next one published */
+    sub->start = topic->published;
+
+    /* link subscriber in front of the topic list */
+    sub->next = topic->subscribers;
+    topic->subscribers = sub;
+
+    /* end critical section and enable interrupts */
+    EndCriticalSection(status);
+
+    /* return error code */
+    return 1;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_Publish
+ * INPUTS: (topic_t *) topic, (const void *) sample
+ * OUTPUTS: void
+ * Publishes a sample to every subscriber
+ *  - Copies the sample once into the topic
+ *  - Only signals subscribers that wait for it
+ *  - Safe from ISRs
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_Publish(topic_t *topic, const void *sample)
+{
+    /* start critical section & disable interrupts */
+    int32_t status = StartCriticalSection();
+
+    /* write sample into the topic ring */
+    uint32_t index = topic->published % topic->depth;
+    memcpy(&topic->samples[index * topic->sampleSize], sample, topic->sampleSize);
+
+    /* wake subscribers waiting for this sample */
+    for (subscriber_t *sub = topic->subscribers; sub != 0; sub = sub->next) {
+        if (sub->waiting && (topic->published - sub->start) % sub->decimation == 0) {
+            sub->waiting = false;
+            G8RTOS_SignalSemaphore(&sub->notify);
+        }
+    }
+
+    topic->published++;
+
+    /* end critical section and enable interrupts */
+    EndCriticalSection(status);
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_TopicReceive
+ * INPUTS: (subscriber_t *) sub, (void *) sample,
+ *         (uint32_t) timeoutMS
+ * OUTPUTS: (bool) received
+ * Copies the oldest queued sample of sub into sample,
+ * waiting at most timeoutMS for one to be published
+ *  - A timeout of 0 never blocks and is safe from ISRs
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+bool G8RTOS_TopicReceive(subscriber_t *sub, void *sample, uint32_t timeoutMS)
+{
+    uint32_t deadline = SystemTime + timeoutMS;
+
+    while (1) {
+        /* start critical section & disable interrupts */
+        int32_t status = StartCriticalSection();
+
+        /* take a queued sample, or announce the wait */
+        bool taken = TakeSample(sub, sample);
+        sub->waiting = !taken && timeoutMS != 0;
+
+        /* end critical section and enable interrupts */
+        EndCriticalSection(status);
+
+        if (taken)
+            return true;
+
+        /* give up once the deadline has passed */
+        uint32_t remaining = (timeoutMS == G8RTOS_WAIT_FOREVER) ? G8RTOS_WAIT_FOREVER : deadline - SystemTime;
+        if (remaining == 0 || remaining > timeoutMS ||
+            !G8RTOS_WaitSemaphoreTimeout(&sub->notify, remaining)) {
+            sub->waiting = false;
+            return false;
+        }
+
+        /* a stale signal may wake the subscriber early, the loop checks again */
+    }
+}
+
+#endif /* G8RTOS_USE_IPC */
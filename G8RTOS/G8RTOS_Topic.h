@@ -0,0 +1,147 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/14/2020                                                |
+ * | SUMMARY: G8RTOS_Topic.h                                         |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifndef G8RTOS_TOPIC_H_
+#define G8RTOS_TOPIC_H_
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "G8RTOS_Semaphores.h"
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                        DEFINES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* words of storage needed by a topic keeping depth samples */
+#define TOPIC_STORAGE_WORDS(sampleSize, depth) ((((sampleSize) + 3) / 4) * (depth))
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                  DATA TYPE DEFINITIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Topic and subscriber typedefs
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+typedef struct topic topic_t;
+typedef struct subscriber subscriber_t;
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Topic
+ * A topic keeps the last depth published samples in a
+ * ring, each sample is stored once no matter how many
+ * subscribers there are. published counts every sample
+ * ever published
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+struct topic {
+    uint8_t *samples;
+    uint32_t sampleSize;
+    uint32_t depth;
+    uint32_t published;
+    subscriber_t *subscribers;
+};
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * Subscriber
+ * A subscriber sees every decimation-th sample published
+ * after it subscribed and queues the newest depth of
+ * them, depth 1 is a latest value slot. Samples are
+ * read from the topic ring, the subscriber only tracks
+ * how many it has taken. lost counts samples that fell
+ * out of the queue unread
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+struct subscriber {
+    topic_t *topic;
+    subscriber_t *next;
+    uint32_t depth;
+    uint32_t decimation;
+    uint32_t start;
+    uint32_t taken;
+    uint32_t lost;
+    bool waiting;
+    semaphore_t notify;
+};
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_InitTopic
+ * INPUTS: (topic_t *) topic, (uint32_t *) storage,
+ *         (uint32_t) sampleSize, (uint32_t) depth
+ * OUTPUTS: (int) error
+ * Initializes a topic with no samples and no subscribers
+ *  - storage must hold TOPIC_STORAGE_WORDS(sampleSize,
+ *    depth) words
+ *  - depth bounds depth * decimation of every subscriber
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_InitTopic(topic_t *topic, uint32_t *storage, uint32_t sampleSize, uint32_t depth);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_Subscribe
+ * INPUTS: (topic_t *) topic, (subscriber_t *) sub,
+ *         (uint32_t) depth, (uint32_t) decimation
+ * OUTPUTS: (int) error
+ * Subscribes sub to samples published from now on
+ *  - Returns -1 if the topic does not keep enough
+ *    samples for depth * decimation
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int G8RTOS_Subscribe(topic_t *topic, subscriber_t *sub, uint32_t depth, uint32_t decimation);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_Publish
+ * INPUTS: (topic_t *) topic, (const void *) sample
+ * OUTPUTS: void
+ * Publishes a sample to every subscriber
+ *  - Copies the sample once into the topic
+ *  - Only signals subscribers that wait for it
+ *  - Safe from ISRs
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void G8RTOS_Publish(topic_t *topic, const void *sample);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * G8RTOS_TopicReceive
+ * INPUTS: (subscriber_t *) sub, (void *) sample,
+ *         (uint32_t) timeoutMS
+ * OUTPUTS: (bool) received
+ * Copies the oldest queued sample of sub into sample,
+ * waiting at most timeoutMS for one to be published
+ *  - A timeout of 0 never blocks and is safe from ISRs
+ *  - CRITICAL SECTION
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+bool G8RTOS_TopicReceive(subscriber_t *sub, void *sample, uint32_t timeoutMS);
+
+#endif /* G8RTOS_TOPIC_H_ */
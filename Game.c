@@ -3,6 +3,10 @@
 #include "G8RTOS_IPC.h"
 #include <driverlib.h>
 
+#if !G8RTOS_USE_IPC || !G8RTOS_USE_TASKS || !G8RTOS_USE_POOL
+#error "the game needs G8RTOS_USE_IPC, G8RTOS_USE_TASKS and G8RTOS_USE_POOL"
+#endif
+
 uint16_t redplayer[SIZE_OF_PLAYER] = {
    LCD_CYAN, LCD_CYAN, LCD_CYAN, LCD_CYAN, LCD_RED, LCD_RED, LCD_RED, LCD_RED, LCD_RED, LCD_RED, LCD_CYAN, LCD_CYAN, LCD_CYAN, LCD_CYAN,
    LCD_CYAN, LCD_CYAN, LCD_CYAN, LCD_CYAN, LCD_RED, LCD_RED, LCD_RED, LCD_RED, LCD_RED, LCD_RED, LCD_CYAN, LCD_CYAN, LCD_CYAN, LCD_CYAN,
@@ -82,31 +86,124 @@ uint16_t blueplayer[SIZE_OF_PLAYER] = {
 };
 
 GameState_t gamestate, packet;
-uint8_t packet_buffer[sizeof(gamestate)], woh_buffer[sizeof(gamestate)];
 
-/* Function to fill in a packet to be sent over through WiFi */
-static inline void fillPacket(GameState_t * packet, uint8_t * buffer) {
-    uint8_t * p = packet;
+/* Writers of gamestate hold this while updating, readers take snapshots through it */
+static seqlock_t gamestateLock;
+
+/* Received packets, owned by the receive thread until handed to updateObjects */
+static pool_t packetPool;
+static union {
+    uint32_t words[POOL_STORAGE_WORDS(sizeof(GameState_t), PACKETS_IN_FLIGHT)];
+    void *align;    // free blocks hold pointers
+} packetStorage;
+static mailbox_t packetMailbox;
+static void *packetSlots[PACKETS_IN_FLIGHT];
+
+/* Semaphores shared by host and client threads */
+static const semaphoreConfig_t gameSemaphores[] = {
+    { &CC3100Semaphore, 1 },
+    { &LCDMutex, 1 },
+};
+
+/* Threads added once the client joined the host */
+static const threadConfig_t clientThreads[] = {
+    { updateObjects, 50, "updateObjects" },
+    { ReceiveDataFromHost, 100, "ReceiveDataFromHost" },
+    { SendDataToHost, 150, "SendDataToHost" },
+    { G8RTOS_TaskScheduler, 200, "TaskScheduler" },
+    { GovernorThread, GOVERNOR_PRIORITY, "Governor" },
+    { TelemetryThread, TELEMETRY_PRIORITY, "Telemetry" },
+    { IdleThread, 254, "IdleThread" },
+};
+
+/* Threads added once the host accepted the client */
+static const threadConfig_t hostThreads[] = {
+    { updateObjects, 50, "updateObjects" },
+    { ReceiveDataFromClient, 100, "ReceiveDataFromClient" },
+    { SendDataToClient, 150, "SendDataToClient" },
+    { G8RTOS_TaskScheduler, 200, "TaskScheduler" },
+    { GovernorThread, GOVERNOR_PRIORITY, "Governor" },
+    { TelemetryThread, TELEMETRY_PRIORITY, "Telemetry" },
+    { IdleThread, 254, "IdleThread" },
+};
+
+/* Time between the starts of two frames */
+G8RTOS_HISTOGRAM(frameTime, "game.frame_ms", 20, 25, 33, 50, 100);
+
+/* Top left corners of the clouds */
+static const int16_t cloudPositions[][2] = {
+    { 0, 0 }, { 30, 15 }, { 100, 12 }, { 150, 35 }, { 200, 5 }, { 230, 17 },
+};
+
+/* Function to set up the pool and mailbox received packets go through */
+static void InitPackets() {
+    G8RTOS_InitPool(&packetPool, packetStorage.words, sizeof(GameState_t), PACKETS_IN_FLIGHT);
+    G8RTOS_InitMailbox(&packetMailbox, packetSlots, PACKETS_IN_FLIGHT);
+}
+
+/* Function to point the governor at the game's backlog: a full packet queue and threads waiting on the radio or LCD */
+static void WatchBacklog() {
+    Governor_Watch(&packetPool.available);
+    Governor_Watch(&packetMailbox.spaces);
+    Governor_Watch(&CC3100Semaphore);
+    Governor_Watch(&LCDMutex);
+}
+
+/* Function to paint every cloud shifted right by drift */
+static void PaintClouds(int16_t drift, uint16_t color) {
+    for (uint32_t i = 0; i < sizeof(cloudPositions) / sizeof(cloudPositions[0]); i++)
+        paintCloud(cloudPositions[i][0] + drift, cloudPositions[i][1], color);
+}
+
+/* Function to copy a consistent snapshot of the game state */
+static void ReadGameState(GameState_t * snapshot) {
+    G8RTOS_SeqlockRead(&gamestateLock, snapshot, &gamestate, sizeof(gamestate));
+}
 
-    for (int i = 0; i < sizeof(*packet); i++) {
-        buffer[i] = *p;
-        p++;
+/* Function to apply a received packet to the local game state */
+static void ApplyPacket(GameState_t * rx) {
+    int32_t status = G8RTOS_SeqlockWriteBegin(&gamestateLock);
+
+    // client takes the host's game state as is
+    if (PLAYER == 1) {
+        gamestate = *rx;
     }
+    // host updates the client's center with the received displacement
+    else {
+        gamestate.players[1].currentCenterX += rx->player.displacementX;
+
+        if( (gamestate.players[1].currentCenterX < 8) || (gamestate.players[1].currentCenterX > 313 ) )
+            gamestate.players[1].currentCenterX -= rx->player.displacementX;
+    }
+
+    G8RTOS_SeqlockWriteEnd(&gamestateLock, status);
 }
 
-/* Function to empty a packet after being sent over through WiFi */
-static inline void emptyPacket(GameState_t * packet, uint8_t * buffer) {
-    uint8_t * p = packet;
+/* Function to receive one packet into a pool buffer and pass it to updateObjects */
+static void ReceivePacket() {
+    GameState_t * rx = G8RTOS_PoolAllocTimeout(&packetPool, G8RTOS_WAIT_FOREVER);
 
-    for (int i = 0; i < sizeof(*packet); i++) {
-        *p = buffer[i];
-        p++;
+    G8RTOS_WaitSemaphore(&CC3100Semaphore);
+    while (ReceiveData((uint8_t *)rx, sizeof(*rx)) < 0)
+    {
+        G8RTOS_SignalSemaphore(&CC3100Semaphore);
+
+        // Sleeps to avoid deadlock
+        G8RTOS_Sleep(1);
+
+        G8RTOS_WaitSemaphore(&CC3100Semaphore);
     }
+    G8RTOS_SignalSemaphore(&CC3100Semaphore);
+
+    // updateObjects owns the packet from now on and frees it
+    G8RTOS_MailboxSend(&packetMailbox, rx, G8RTOS_WAIT_FOREVER);
 }
 
 void JoinGame() {
     // connect client
+    G8RTOS_BootBegin("initCC3100");
     initCC3100(Client);
+    G8RTOS_BootEnd();
 
     // set initial SpecificPlayerInfo_t strict attributes
     gamestate.player.IP_address = getLocalIP();
@@ -117,34 +214,35 @@ void JoinGame() {
     gamestate.player.joined = false;
     gamestate.player.acknowledge = true;
 
-    // fill packet to send
-    fillPacket(&gamestate, &packet_buffer);
-
     // send player info to host & wait for server response
-    //do SendData(packet_buffer, HOST_IP_ADDR, sizeof(packet_buffer));
-
-    while(ReceiveData(woh_buffer, sizeof(woh_buffer)) < 0){
-        SendData(packet_buffer, HOST_IP_ADDR, sizeof(packet_buffer));
+    G8RTOS_BootBegin("wait_host");
+    while(ReceiveData((uint8_t *)&packet, sizeof(packet)) < 0){
+        SendData((uint8_t *)&gamestate, HOST_IP_ADDR, sizeof(gamestate));
     };
+    G8RTOS_BootEnd();
 
-    emptyPacket(&packet, &woh_buffer);
     gamestate = packet;
 
     // turn on LED
     BITBAND_PERI(P1->OUT, 0) = !BITBAND_PERI(P1->OUT, 0);
 
     // add semaphores
-    G8RTOS_InitSemaphore(&CC3100Semaphore, 1);
-    G8RTOS_InitSemaphore(&LCDMutex, 1);
+    G8RTOS_InitSemaphores(gameSemaphores, sizeof(gameSemaphores) / sizeof(gameSemaphores[0]));
+    G8RTOS_InitSeqlock(&gamestateLock);
+    InitPackets();
+    WatchBacklog();
 
+    G8RTOS_BootBegin("InitBoardState");
     InitBoardState();
+    G8RTOS_BootEnd();
+
+    // game_start, begun in main
+    G8RTOS_BootEnd();
+    G8RTOS_BootPrint();
 
     // add threads
-    G8RTOS_AddThread(updateObjects, 50, "updateObjects");
-    G8RTOS_AddThread(ReceiveDataFromHost, 100, "ReceiveDataFromHost");
-    G8RTOS_AddThread(SendDataToHost, 150, "SendDataToHost");
-    G8RTOS_AddThread(ReadJoystickClient, 200, "ReadJoystickClient");
-    G8RTOS_AddThread(IdleThread, 254, "IdleThread");
+    G8RTOS_AddTask(ReadJoystickClient);
+    G8RTOS_AddThreads(clientThreads, sizeof(clientThreads) / sizeof(clientThreads[0]));
 
     // kill self
     G8RTOS_KillSelf();
@@ -155,22 +253,13 @@ void JoinGame() {
  */
 void ReceiveDataFromHost()
 {
+    // a burst of packets may not crowd out the other threads
+    G8RTOS_SetThreadBudget(G8RTOS_GetThreadId(), RECEIVE_BUDGET_MS, RECEIVE_BUDGET_PERIOD_MS, BUDGET_DEMOTE);
+
     while (1)
     {
-        G8RTOS_WaitSemaphore(&CC3100Semaphore);
-        while (ReceiveData(packet_buffer, sizeof(packet_buffer)) < 0)
-        {
-            G8RTOS_SignalSemaphore(&CC3100Semaphore);
-
-            // Sleeps to avoid deadlock
-            G8RTOS_Sleep(1);
-
-            G8RTOS_WaitSemaphore(&CC3100Semaphore);
-        }
-        G8RTOS_SignalSemaphore(&CC3100Semaphore);
-
-        // Empties the packets content
-        emptyPacket(&gamestate, &packet_buffer);
+        // Receives the host's game state
+        ReceivePacket();
 
         //Check if game is done
 //        if (gamestate.gameDone)
@@ -185,54 +274,70 @@ void ReceiveDataFromHost()
  */
 void SendDataToHost()
 {
+    GameState_t snapshot;
+    int32_t status;
+    uint32_t lastWake = SystemTime;
+
     while (1)
     {
-        //fill packet to send
-        fillPacket(&gamestate, &packet_buffer);
+        //send a consistent copy of the game state
+        ReadGameState(&snapshot);
 
-        //send packet
         G8RTOS_WaitSemaphore(&CC3100Semaphore);
-        SendData(packet_buffer, HOST_IP_ADDR, sizeof(packet_buffer));
+        SendData((uint8_t *)&snapshot, HOST_IP_ADDR, sizeof(snapshot));
         G8RTOS_SignalSemaphore(&CC3100Semaphore);
 
         //adjust clients displacement after being sent once
+        status = G8RTOS_SeqlockWriteBegin(&gamestateLock);
         gamestate.player.displacementX = 0;
         gamestate.player.displacementY = 0;
+        G8RTOS_SeqlockWriteEnd(&gamestateLock, status);
 
-        G8RTOS_Sleep(2);
+        // sends every 2ms at full quality
+        G8RTOS_SleepUntil(&lastWake, 2 * Quality->sendDivider);
     }
 }
 
 /*
- * Thread to read client's joystick
+ * Task to read client's joystick
  */
-void ReadJoystickClient() {
+taskStatus_t ReadJoystickClient(task_t *task) {
     int16_t xCord, yCord;
+    int32_t status;
+
+    TASK_BEGIN(task);
 
     while (1) {
         GetJoystickCoordinates(&xCord, &yCord);
 
+        status = G8RTOS_SeqlockWriteBegin(&gamestateLock);
         if (xCord < -1800) gamestate.player.displacementX = 4;
         else if (xCord > 1800) gamestate.player.displacementX = -4;
         else gamestate.player.displacementX = 0;
+        G8RTOS_SeqlockWriteEnd(&gamestateLock, status);
 
         // Sleep 10ms
-        G8RTOS_Sleep(10);
+        TASK_AWAIT_SLEEP(task, 10);
     }
+
+    TASK_END(task);
 }
 
 //================================== Host Threads
 
 void CreateGame() {
     // set host mode
+    G8RTOS_BootBegin("initCC3100");
     initCC3100(Host);
+    G8RTOS_BootEnd();
 
     // receive packet from client
+    G8RTOS_BootBegin("wait_client");
     while(!packet.player.acknowledge) {
-        ReceiveData(packet_buffer, sizeof(packet_buffer));
-        emptyPacket(&packet, &packet_buffer);
+        ReceiveData((uint8_t *)&packet, sizeof(packet));
         gamestate = packet;
     }
+    G8RTOS_BootEnd();
 
     // copy player attributes including
     gamestate.player = packet.player;
@@ -258,23 +363,27 @@ void CreateGame() {
     // acknowledge to client that player has joined
     gamestate.player.joined = true;
     //gamestate.player.acknowledge = true;
-    fillPacket(&gamestate, &packet_buffer);
-    SendData(packet_buffer, gamestate.player.IP_address, sizeof(packet_buffer));
+    SendData((uint8_t *)&gamestate, gamestate.player.IP_address, sizeof(gamestate));
 
     // add semaphores
-    G8RTOS_InitSemaphore(&CC3100Semaphore, 1);
-    G8RTOS_InitSemaphore(&LCDMutex, 1);
+    G8RTOS_InitSemaphores(gameSemaphores, sizeof(gameSemaphores) / sizeof(gameSemaphores[0]));
+    G8RTOS_InitSeqlock(&gamestateLock);
+    InitPackets();
+    WatchBacklog();
 
     // initialize the arena, paddles, scores
+    G8RTOS_BootBegin("InitBoardState");
     InitBoardState();
+    G8RTOS_BootEnd();
+
+    // game_start, begun in main
+    G8RTOS_BootEnd();
+    G8RTOS_BootPrint();
 
 
     // add threads
-    G8RTOS_AddThread(updateObjects, 50, "updateObjects");
-    G8RTOS_AddThread(ReceiveDataFromClient, 100, "ReceiveDataFromClient");
-    G8RTOS_AddThread(SendDataToClient, 150, "SendDataToClient");
-    G8RTOS_AddThread(ReadJoystickHost, 200, "ReadJoystickHost");
-    G8RTOS_AddThread(IdleThread, 254, "IdleThread");
+    G8RTOS_AddTask(ReadJoystickHost);
+    G8RTOS_AddThreads(hostThreads, sizeof(hostThreads) / sizeof(hostThreads[0]));
 
     G8RTOS_KillSelf();
 }
@@ -284,22 +393,24 @@ void CreateGame() {
  */
 void SendDataToClient()
 {
+    GameState_t snapshot;
+    uint32_t lastWake = SystemTime;
+
     while (1)
     {
-        // Fills the packet for the client
-        fillPacket(&gamestate, &packet_buffer);
+        // Sends a consistent copy of the game state to the client
+        ReadGameState(&snapshot);
 
-        // Sends the packet to the client
         G8RTOS_WaitSemaphore(&CC3100Semaphore);
-        SendData(packet_buffer, gamestate.player.IP_address, sizeof(packet_buffer));
+        SendData((uint8_t *)&snapshot, snapshot.player.IP_address, sizeof(snapshot));
         G8RTOS_SignalSemaphore(&CC3100Semaphore);
 
         // Checks to see if the game is done
 //        if (gamestate.gameDone)
 //            G8RTOS_AddThread(EndOfGameHost, 1, "EndGameHost"); // Thread to end the game
 
-        // Sleeps for 5ms (good amount of time for synchronization)
-        G8RTOS_Sleep(5);
+        // Sends every 5ms (good amount of time for synchronization) at full quality
+        G8RTOS_SleepUntil(&lastWake, 5 * Quality->sendDivider);
     }
 }
 
@@ -308,39 +419,29 @@ void SendDataToClient()
  */
 void ReceiveDataFromClient()
 {
+    // a burst of packets may not crowd out the other threads
+    G8RTOS_SetThreadBudget(G8RTOS_GetThreadId(), RECEIVE_BUDGET_MS, RECEIVE_BUDGET_PERIOD_MS, BUDGET_DEMOTE);
+
     while (1)
     {
-        G8RTOS_WaitSemaphore(&CC3100Semaphore);
-        while (ReceiveData(packet_buffer, sizeof(packet_buffer)) < 0)
-        {
-            G8RTOS_SignalSemaphore(&CC3100Semaphore);
-
-            // Sleeps to avoid deadlock
-            G8RTOS_Sleep(1);
-
-            G8RTOS_WaitSemaphore(&CC3100Semaphore);
-        }
-        G8RTOS_SignalSemaphore(&CC3100Semaphore);
-
-        // Empties the packets content
-        emptyPacket(&packet, &packet_buffer);
-
-        //  Updates the players current center with the received displacement
-
-        gamestate.players[1].currentCenterX += packet.player.displacementX;
-
-        if( (gamestate.players[1].currentCenterX < 8) || (gamestate.players[1].currentCenterX > 313 ) )
-                    gamestate.players[1].currentCenterX -= packet.player.displacementX;
+        // Receives the client's displacement
+        ReceivePacket();
 
         G8RTOS_Sleep(2);
     }
 }
 
 /*
- * Thread to read host's joystick
+ * Task to read host's joystick
  */
-void ReadJoystickHost() {
-    int16_t xCord, yCord, displacement;
+taskStatus_t ReadJoystickHost(task_t *task) {
+    int16_t xCord, yCord;
+    int32_t status;
+
+    // displacement is kept across the sleep below
+    static int16_t displacement;
+
+    TASK_BEGIN(task);
 
     while (1) {
         GetJoystickCoordinates(&xCord, &yCord);
@@ -350,52 +451,99 @@ void ReadJoystickHost() {
         else displacement = 0;
 
         // Sleep to give fair advantage to client
-        G8RTOS_Sleep(10);
+        TASK_AWAIT_SLEEP(task, 10);
 
         // Update position of host paddle
+        status = G8RTOS_SeqlockWriteBegin(&gamestateLock);
         gamestate.players[0].currentCenterX += displacement;
 
         if( (gamestate.players[0].currentCenterX < 8) || (gamestate.players[0].currentCenterX > 313) )
             gamestate.players[0].currentCenterX -= displacement;
+        G8RTOS_SeqlockWriteEnd(&gamestateLock, status);
     }
+
+    TASK_END(task);
 }
 
-void drawClouds(int16_t x, int16_t y)
+void paintCloud(int16_t x, int16_t y, uint16_t color)
 {
-    LCD_DrawRectangle(25 + x, 35 + x, 5 + y, 10 + y, LCD_WHITE);
-    LCD_DrawRectangle(20 + x, 35 + x, 10 + y, 15 + y, LCD_WHITE);
-    LCD_DrawRectangle(55 + x, 60 + x, 10 + y, 15 + y, LCD_WHITE);
-    LCD_DrawRectangle(20 + x, 40 + x, 15 + y, 20 + y, LCD_WHITE);
-    LCD_DrawRectangle(50 + x, 60 + x, 15 + y, 20 + y, LCD_WHITE);
-    LCD_DrawRectangle(15 + x, 65 + x, 20 + y, 25 + y, LCD_WHITE);
-    LCD_DrawRectangle(10 + x, 70 + x, 25 + y, 30 + y, LCD_WHITE);
-    LCD_DrawRectangle(0 + x, 80 + x, 30 + y, 33 + y, LCD_WHITE);
+    LCD_DrawRectangle(25 + x, 35 + x, 5 + y, 10 + y, color);
+    LCD_DrawRectangle(20 + x, 35 + x, 10 + y, 15 + y, color);
+    LCD_DrawRectangle(55 + x, 60 + x, 10 + y, 15 + y, color);
+    LCD_DrawRectangle(20 + x, 40 + x, 15 + y, 20 + y, color);
+    LCD_DrawRectangle(50 + x, 60 + x, 15 + y, 20 + y, color);
+    LCD_DrawRectangle(15 + x, 65 + x, 20 + y, 25 + y, color);
+    LCD_DrawRectangle(10 + x, 70 + x, 25 + y, 30 + y, color);
+    LCD_DrawRectangle(0 + x, 80 + x, 30 + y, 33 + y, color);
 }
 
 void updateObjects()
 {
     PrevPlayer_t prevPlayers[MAX_NUM_OF_PLAYERS];
+    GameState_t frame;
+    uint32_t lastWake = SystemTime, lastFrame = SystemTime;
 
-    prevPlayers[0].centerX = gamestate.players[0].currentCenterX;
-    prevPlayers[0].centerY = gamestate.players[0].currentCenterY;
-    prevPlayers[1].centerX = gamestate.players[1].currentCenterX;
-    prevPlayers[1].centerY = gamestate.players[1].currentCenterY;
+    G8RTOS_RegisterMetric(&frameTime);
+
+    ReadGameState(&frame);
+    prevPlayers[0].centerX = frame.players[0].currentCenterX;
+    prevPlayers[0].centerY = frame.players[0].currentCenterY;
+    prevPlayers[1].centerX = frame.players[1].currentCenterX;
+    prevPlayers[1].centerY = frame.players[1].currentCenterY;
+
+    GameState_t * rx;
+    uint32_t frames = 0, packets;
+    int16_t cloudDrift = 0, cloudStep = 1;
+    bool ledOn = false;
 
     while(1)
     {
+        G8RTOS_MetricObserve(&frameTime, SystemTime - lastFrame);
+        lastFrame = SystemTime;
+
+        // apply every packet received since the last frame, then free it
+        packets = 0;
+        while ((rx = G8RTOS_MailboxReceive(&packetMailbox, 0)) != 0) {
+            ApplyPacket(rx);
+            G8RTOS_PoolFree(&packetPool, rx);
+            packets++;
+        }
+
+        // draw the whole frame from one consistent snapshot
+        ReadGameState(&frame);
+
         for(int i=0; i<MAX_NUM_OF_PLAYERS; i++) {
-            if(gamestate.players[i].currentCenterX != prevPlayers[i].centerX){
+            if(frame.players[i].currentCenterX != prevPlayers[i].centerX){
                 G8RTOS_WaitSemaphore(&LCDMutex);
-                ErasePlayer(prevPlayers[i].centerX, prevPlayers[i].centerY);
-                if(gamestate.players[i].color == player1) DrawPlayer(gamestate.players[i].currentCenterX, gamestate.players[i].currentCenterY, redplayer);
-                else DrawPlayer(gamestate.players[i].currentCenterX, gamestate.players[i].currentCenterY, blueplayer);
+                MovePlayer(prevPlayers[i].centerX, prevPlayers[i].centerY,
+                           frame.players[i].currentCenterX, frame.players[i].currentCenterY,
+                           frame.players[i].color == player1 ? redplayer : blueplayer);
                 G8RTOS_SignalSemaphore(&LCDMutex);
-                prevPlayers[i].centerX = gamestate.players[i].currentCenterX;
-                prevPlayers[i].centerY = gamestate.players[i].currentCenterY;
+                prevPlayers[i].centerX = frame.players[i].currentCenterX;
+                prevPlayers[i].centerY = frame.players[i].currentCenterY;
             }
         }
 
-        G8RTOS_Sleep(20);
+        // optional effects, the governor turns them off under load
+        frames++;
+        if (Quality->clouds && frames % CLOUD_STEP_FRAMES == 0) {
+            if (cloudDrift + cloudStep < 0 || cloudDrift + cloudStep > CLOUD_DRIFT_PX) cloudStep = -cloudStep;
+
+            G8RTOS_WaitSemaphore(&LCDMutex);
+            PaintClouds(cloudDrift, LCD_CYAN);
+            cloudDrift += cloudStep;
+            PaintClouds(cloudDrift, LCD_WHITE);
+            G8RTOS_SignalSemaphore(&LCDMutex);
+        }
+
+        bool ledWanted = Quality->leds && packets > 0;
+        if (ledWanted != ledOn && BSP_IsReady(BSP_RGBLEDS)) {
+            LP3943_LedModeSet(GREEN, ledWanted ? PACKET_LED : 0);
+            ledOn = ledWanted;
+        }
+
+        // redraw every 20ms at full quality
+        Governor_FrameDone(G8RTOS_SleepUntil(&lastWake, Quality->frameMS));
     }
 }
 
@@ -418,12 +566,7 @@ void InitBoardState()
     }
 
     // Draw clouds
-    drawClouds(0, 0);
-    drawClouds(30, 15);
-    drawClouds(100, 12);
-    drawClouds(150, 35);
-    drawClouds(200, 5);
-    drawClouds(230, 17);
+    PaintClouds(0, LCD_WHITE);
 
     G8RTOS_SignalSemaphore(&LCDMutex);
 }
@@ -433,12 +576,33 @@ void DrawPlayer(uint16_t x, uint16_t y, uint16_t player[])
     LCD_DrawRectangleWithColor(x-6, x+7, y-21, y+14, player);
 }
 
-void ErasePlayer(uint16_t x, uint16_t y)
+void MovePlayer(uint16_t oldX, uint16_t oldY, uint16_t x, uint16_t y, uint16_t player[])
 {
-    LCD_DrawRectangle(x-6, x+7, y-21, y+14, LCD_CYAN);
+    // repaints only the sky the player uncovered, then the player
+    LCD_MoveSprite(oldX-6, oldY-21, x-6, y-21, PLAYER_WIDTH, PLAYER_HEIGHT, player, LCD_CYAN);
+}
+
+void TelemetryThread()
+{
+    static char record[METRICS_RECORD_SIZE];
+    uint32_t lastWake = SystemTime;
+
+    while(1)
+    {
+        G8RTOS_SleepUntil(&lastWake, TELEMETRY_PERIOD_MS);
+
+        // one record, written to the back channel and sent to the collector
+        uint32_t length = G8RTOS_MetricsWrite(record, METRICS_RECORD_SIZE);
+        if (length) {
+            G8RTOS_WaitSemaphore(&CC3100Semaphore);
+            SendTelemetry((uint8_t *)record, length);
+            G8RTOS_SignalSemaphore(&CC3100Semaphore);
+        }
+    }
 }
 
 void IdleThread()
 {
-    while(1);
+    // the governor measures CPU load by the time spent here
+    while(1) Governor_Idle();
 }
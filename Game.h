@@ -7,13 +7,35 @@
 #include "G8RTOS.h"
 #include "cc3100_usage.h"
 #include "LCDLib.h"
+#include "LCDDirty.h"
 #include "time.h"
 #include "stdlib.h"
 #include "BSP.h"
+#include "Governor.h"
 /*********************************************** Includes ********************************************************************/
 #define MAX_NUM_OF_PLAYERS  2
 #define PLAYER 0
 #define SIZE_OF_PLAYER 504
+#define PLAYER_WIDTH 14
+#define PLAYER_HEIGHT 36
+
+/* Received packets that can be queued for updateObjects at once */
+#define PACKETS_IN_FLIGHT 16
+
+/* CPU (ms) the receive threads may use per budget period before they are demoted */
+#define RECEIVE_BUDGET_MS 4
+#define RECEIVE_BUDGET_PERIOD_MS 20
+
+/* Clouds drift right and back by this many pixels, one pixel every CLOUD_STEP_FRAMES frames */
+#define CLOUD_DRIFT_PX 8
+#define CLOUD_STEP_FRAMES 10
+
+/* LED of the green LP3943 unit lit on frames that applied a packet */
+#define PACKET_LED 0x0001
+
+/* Metrics record sent over the back channel and to the telemetry collector this often */
+#define TELEMETRY_PERIOD_MS 1000
+#define TELEMETRY_PRIORITY 230
 
 /* Size of game arena */
 #define ARENA_MIN_X                  0
@@ -71,19 +93,20 @@ typedef struct
 void JoinGame();
 void SendDataToHost();
 void ReceiveDataFromHost();
-void ReadJoystickHost();
+taskStatus_t ReadJoystickHost(task_t *task);
 
 void CreateGame();
 void SendDataToClient();
 void ReceiveDataFromClient();
-void ReadJoystickClient();
+taskStatus_t ReadJoystickClient(task_t *task);
 
 //Common Threads
 void InitBoardState();
 void IdleThread();
+void TelemetryThread();
 void DrawPlayer(uint16_t x, uint16_t y, uint16_t player[]);
-void ErasePlayer(uint16_t x, uint16_t y);
-void drawClouds(int16_t x, int16_t y);
+void MovePlayer(uint16_t oldX, uint16_t oldY, uint16_t x, uint16_t y, uint16_t player[]);
+void paintCloud(int16_t x, int16_t y, uint16_t color);
 void updateObjects();
 
 #endif /* GAME_H_ */
@@ -0,0 +1,150 @@
+#include "Governor.h"
+#include <stdio.h>
+#include "BackChannelUart.h"
+#include "G8RTOS_Port.h"
+#include "G8RTOS_CriticalSection.h"
+
+/* Idle loop gaps longer than this (us) mean the idle thread was switched out */
+#define IDLE_GAP_US 50
+
+/* Length of one log line */
+#define LOG_LENGTH 96
+
+/* Quality levels, each one sheds more than the one before */
+static const QualityLevel_t Levels[] = {
+    { 1, 20, true,  true  },    // full quality
+    { 1, 20, true,  false },    // LEDs off
+    { 2, 25, false, false },    // half the send rate, clouds stop
+    { 3, 33, false, false },
+    { 4, 50, false, false },    // floor, 20 frames a second
+};
+
+#define NUM_LEVELS (sizeof(Levels) / sizeof(Levels[0]))
+
+const QualityLevel_t * volatile Quality = &Levels[0];
+
+/* Semaphores whose backlog is watched */
+static semaphore_t * Watched[GOVERNOR_MAX_WATCHED];
+static uint32_t NumberWatched;
+
+/* Cycles the idle thread ran, only ever grows so the governor reads differences */
+static volatile uint32_t IdleCycles;
+static uint32_t LastIdleCycles;
+static uint32_t IdleGapCycles;
+
+/* Frames that missed their release since the last window */
+static volatile uint32_t LateFrames;
+
+/* Current level and CPU load of the last window, for telemetry */
+G8RTOS_GAUGE(LevelMetric, "governor.level");
+G8RTOS_GAUGE(LoadMetric, "governor.load");
+
+/* Function to count the threads blocked on the watched semaphores */
+static uint32_t Backlog() {
+    uint32_t backlog = 0;
+
+    for (uint32_t i = 0; i < NumberWatched; i++) {
+        int32_t value = *Watched[i];
+
+        if (value < 0) backlog += -value;
+    }
+
+    return backlog;
+}
+
+/* Function to switch to level and log why */
+static void SetLevel(uint32_t from, uint32_t to, uint32_t load, uint32_t backlog, uint32_t late) {
+    char line[LOG_LENGTH];
+
+    Quality = &Levels[to];
+    G8RTOS_MetricSet(&LevelMetric, to);
+
+    snprintf(line, LOG_LENGTH, "governor: level %lu -> %lu, load %lu%%, backlog %lu, late %lu\r\n",
+             (unsigned long)from, (unsigned long)to, (unsigned long)load,
+             (unsigned long)backlog, (unsigned long)late);
+    BackChannelWrite(line);
+}
+
+void Governor_Watch(semaphore_t *s) {
+    if (NumberWatched == GOVERNOR_MAX_WATCHED)
+        return;
+
+    Watched[NumberWatched++] = s;
+}
+
+void Governor_Idle() {
+    uint32_t now = G8RTOS_PortCycles();
+    uint32_t delta = now - LastIdleCycles;
+    LastIdleCycles = now;
+
+    if (delta < IdleGapCycles)
+        IdleCycles += delta;
+}
+
+void Governor_FrameDone(uint32_t lateMS) {
+    if (lateMS > 0)
+        LateFrames++;
+}
+
+void GovernorThread() {
+    uint32_t level = 0, strained = 0, calm = 0;
+
+    G8RTOS_RegisterMetric(&LevelMetric);
+    G8RTOS_RegisterMetric(&LoadMetric);
+
+    G8RTOS_PortInitCycles();
+    IdleGapCycles = G8RTOS_PortCyclesPerMS() * IDLE_GAP_US / 1000;
+
+    uint32_t lastCycles = G8RTOS_PortCycles();
+    uint32_t lastIdle = IdleCycles;
+    uint32_t lastWake = SystemTime;
+
+    while (1)
+    {
+        G8RTOS_SleepUntil(&lastWake, GOVERNOR_PERIOD_MS);
+
+        // measure the window that just ended
+        uint32_t cycles = G8RTOS_PortCycles();
+        uint32_t idle = IdleCycles;
+        uint32_t elapsed = cycles - lastCycles;
+        uint32_t idleInWindow = idle - lastIdle;
+        lastCycles = cycles;
+        lastIdle = idle;
+
+        if (idleInWindow > elapsed) idleInWindow = elapsed;
+        uint32_t load = 100 - (uint32_t)((uint64_t)idleInWindow * 100 / elapsed);
+        G8RTOS_MetricSet(&LoadMetric, load);
+
+        int32_t status = StartCriticalSection();
+        uint32_t late = LateFrames;
+        LateFrames = 0;
+        EndCriticalSection(status);
+
+        uint32_t backlog = Backlog();
+
+        bool pressure = load >= GOVERNOR_LOAD_HIGH || backlog >= GOVERNOR_BACKLOG_HIGH || late >= GOVERNOR_LATE_HIGH;
+        bool relief = load <= GOVERNOR_LOAD_LOW && backlog == 0 && late == 0;
+
+        // step down after a few strained windows, back up only after a longer calm
+        if (pressure) {
+            calm = 0;
+            if (++strained >= GOVERNOR_DOWN_WINDOWS && level < NUM_LEVELS - 1) {
+                SetLevel(level, level + 1, load, backlog, late);
+                level++;
+                strained = 0;
+            }
+        }
+        else if (relief) {
+            strained = 0;
+            if (++calm >= GOVERNOR_UP_WINDOWS && level > 0) {
+                SetLevel(level, level - 1, load, backlog, late);
+                level--;
+                calm = 0;
+            }
+        }
+        else {
+            strained = 0;
+            calm = 0;
+        }
+    }
+}
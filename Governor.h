@@ -0,0 +1,69 @@
+#ifndef GOVERNOR_H_
+#define GOVERNOR_H_
+
+/*********************************************** Includes ********************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "G8RTOS.h"
+/*********************************************** Includes ********************************************************************/
+
+/* How often the governor looks at the game, and its priority (above updateObjects so it still runs when frames stall) */
+#define GOVERNOR_PERIOD_MS           250
+#define GOVERNOR_PRIORITY            40
+
+/* A window is under pressure if any of these is reached */
+#define GOVERNOR_LOAD_HIGH           90      /* % CPU */
+#define GOVERNOR_BACKLOG_HIGH        2       /* threads blocked on watched semaphores */
+#define GOVERNOR_LATE_HIGH           2       /* frames that missed their release */
+
+/* A window is calm only if CPU load is at most this, nothing is blocked on a watched semaphore and no frame was late */
+#define GOVERNOR_LOAD_LOW            60
+
+/* Hysteresis, windows in a row before stepping quality down or back up */
+#define GOVERNOR_DOWN_WINDOWS        2
+#define GOVERNOR_UP_WINDOWS          8
+
+/* Most semaphores the governor watches */
+#define GOVERNOR_MAX_WATCHED         4
+
+/*
+ * Settings of one quality level, level 0 is full quality
+ */
+typedef struct
+{
+    uint8_t sendDivider;    // network sends happen every sendDivider base periods
+    uint8_t frameMS;        // updateObjects redraw period
+    bool clouds;            // drifting clouds
+    bool leds;              // packet activity on the LEDs
+} QualityLevel_t;
+
+/* Current quality level, read by the game threads every period */
+extern const QualityLevel_t * volatile Quality;
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Counts the threads blocked on s as backlog, call before adding GovernorThread
+ * For a FIFO, pool or mailbox watch the semaphore counting its free space, so a full queue shows up
+ */
+void Governor_Watch(semaphore_t *s);
+
+/*
+ * Counts the time the idle thread runs as idle CPU, call it in the idle loop
+ */
+void Governor_Idle();
+
+/*
+ * Reports one frame of updateObjects, lateMS as returned by G8RTOS_SleepUntil
+ */
+void Governor_FrameDone(uint32_t lateMS);
+
+/*
+ * Thread that steps Quality down while CPU, backlog or frame time are under
+ * pressure and back up once they are calm, logging every change
+ */
+void GovernorThread();
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* GOVERNOR_H_ */
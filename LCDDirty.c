@@ -0,0 +1,236 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/23/2020                                                |
+ * | SUMMARY: LCDDirty.c                                             |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#include <stdbool.h>
+#include "LCDDirty.h"
+
+/* Rectangles waiting to be repainted, no two are worth merging */
+static Rect Dirty[LCD_MAX_DIRTY];
+static uint32_t NumberDirty;
+
+/************************************  Private Functions  *******************************************/
+
+/*******************************************************************************
+ * Function Name  : RectArea
+ * Description    : Pixels in a rectangle
+ * Input          : r
+ * Output         : None
+ * Return         : Area
+ * Attention      : r must not be empty
+ *******************************************************************************/
+static int32_t RectArea(const Rect *r)
+{
+    return (int32_t)(r->xEnd - r->xStart + 1) * (r->yEnd - r->yStart + 1);
+}
+
+/*******************************************************************************
+ * Function Name  : RectOverlaps
+ * Description    : Whether two rectangles share a pixel
+ * Input          : a, b
+ * Output         : None
+ * Return         : true if they overlap
+ * Attention      : None
+ *******************************************************************************/
+static bool RectOverlaps(const Rect *a, const Rect *b)
+{
+    return a->xStart <= b->xEnd && b->xStart <= a->xEnd &&
+           a->yStart <= b->yEnd && b->yStart <= a->yEnd;
+}
+
+/*******************************************************************************
+ * Function Name  : RectUnion
+ * Description    : Smallest rectangle holding both a and b
+ * Input          : a, b
+ * Output         : None
+ * Return         : Union
+ * Attention      : None
+ *******************************************************************************/
+static Rect RectUnion(const Rect *a, const Rect *b)
+{
+    Rect u;
+
+    u.xStart = a->xStart < b->xStart ? a->xStart : b->xStart;
+    u.xEnd = a->xEnd > b->xEnd ? a->xEnd : b->xEnd;
+    u.yStart = a->yStart < b->yStart ? a->yStart : b->yStart;
+    u.yEnd = a->yEnd > b->yEnd ? a->yEnd : b->yEnd;
+
+    return u;
+}
+
+/*******************************************************************************
+ * Function Name  : RectDifference
+ * Description    : Splits the part of a outside b into rectangles
+ * Input          : a, b
+ * Output         : out: up to 4 rectangles, full width strips above and
+ *                  below b first, then the strips beside it
+ * Return         : Number of rectangles
+ * Attention      : None
+ *******************************************************************************/
+static uint32_t RectDifference(const Rect *a, const Rect *b, Rect out[4])
+{
+    uint32_t n = 0;
+
+    if (!RectOverlaps(a, b))
+    {
+        out[0] = *a;
+        return 1;
+    }
+
+    int16_t top = a->yStart;
+    int16_t bottom = a->yEnd;
+
+    if (b->yStart > a->yStart)
+    {
+        out[n++] = (Rect){ a->xStart, a->xEnd, a->yStart, b->yStart - 1 };
+        top = b->yStart;
+    }
+    if (b->yEnd < a->yEnd)
+    {
+        out[n++] = (Rect){ a->xStart, a->xEnd, b->yEnd + 1, a->yEnd };
+        bottom = b->yEnd;
+    }
+    if (b->xStart > a->xStart)
+        out[n++] = (Rect){ a->xStart, b->xStart - 1, top, bottom };
+    if (b->xEnd < a->xEnd)
+        out[n++] = (Rect){ b->xEnd + 1, a->xEnd, top, bottom };
+
+    return n;
+}
+
+/*******************************************************************************
+ * Function Name  : RectWorthMerging
+ * Description    : Whether one window over the union of a and b costs no
+ *                  more than a window each
+ * Input          : a, b
+ * Output         : None
+ * Return         : true to merge
+ * Attention      : Overlapping pixels are sent twice by two windows
+ *******************************************************************************/
+static bool RectWorthMerging(const Rect *a, const Rect *b)
+{
+    Rect u = RectUnion(a, b);
+
+    return RectArea(&u) <= RectArea(a) + RectArea(b) + LCD_WINDOW_COST_PX;
+}
+
+/************************************  Private Functions  *******************************************/
+
+
+/************************************  Public Functions  *******************************************/
+
+/*******************************************************************************
+ * Function Name  : LCD_Invalidate
+ * Description    : Marks a rectangle to be repainted with the background
+ * Input          : xStart, xEnd, yStart, yEnd
+ * Output         : None
+ * Return         : None
+ * Attention      : Ends are inclusive, as in LCD_DrawRectangle. The
+ *                  rectangle is merged with any waiting one whose union
+ *                  costs less than a second window
+ *******************************************************************************/
+void LCD_Invalidate(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd)
+{
+    /* clip to the screen, nothing left is nothing to repaint */
+    if (xStart < MIN_SCREEN_X)
+        xStart = MIN_SCREEN_X;
+    if (xEnd > MAX_SCREEN_X - 1)
+        xEnd = MAX_SCREEN_X - 1;
+    if (yStart < MIN_SCREEN_Y)
+        yStart = MIN_SCREEN_Y;
+    if (yEnd > MAX_SCREEN_Y - 1)
+        yEnd = MAX_SCREEN_Y - 1;
+    if (xStart > xEnd || yStart > yEnd)
+        return;
+
+    Rect r = { xStart, xEnd, yStart, yEnd };
+
+    /* fold in every waiting rectangle worth it, a grown one is checked against the rest again */
+    uint32_t i = 0;
+    while (i < NumberDirty)
+    {
+        if (RectWorthMerging(&Dirty[i], &r))
+        {
+            r = RectUnion(&Dirty[i], &r);
+            Dirty[i] = Dirty[--NumberDirty];
+            i = 0;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    /* list full, merge with the rectangle that grows the least */
+    if (NumberDirty == LCD_MAX_DIRTY)
+    {
+        uint32_t closest = 0;
+        int32_t leastGrowth = INT32_MAX;
+
+        for (i = 0; i < NumberDirty; i++)
+        {
+            Rect u = RectUnion(&Dirty[i], &r);
+            int32_t growth = RectArea(&u) - RectArea(&Dirty[i]);
+
+            if (growth < leastGrowth)
+            {
+                leastGrowth = growth;
+                closest = i;
+            }
+        }
+
+        r = RectUnion(&Dirty[closest], &r);
+        Dirty[closest] = Dirty[--NumberDirty];
+    }
+
+    Dirty[NumberDirty++] = r;
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_RepaintDirty
+ * Description    : Fills every waiting rectangle with Color and empties the list
+ * Input          : Color
+ * Output         : None
+ * Return         : None
+ * Attention      : None
+ *******************************************************************************/
+void LCD_RepaintDirty(uint16_t Color)
+{
+    for (uint32_t i = 0; i < NumberDirty; i++)
+        LCD_DrawRectangle(Dirty[i].xStart, Dirty[i].xEnd, Dirty[i].yStart, Dirty[i].yEnd, Color);
+
+    NumberDirty = 0;
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_MoveSprite
+ * Description    : Moves a sprite drawn at (xOld, yOld) to (xNew, yNew)
+ * Input          : xOld, yOld, xNew, yNew: top left corners
+ *                  width, height, Sprite: pixels as in LCD_DrawRectangleWithColor
+ *                  Background: color behind the sprite
+ * Output         : None
+ * Return         : None
+ * Attention      : Repaints only the part of the old box the new one does
+ *                  not cover, then draws the sprite once
+ *******************************************************************************/
+void LCD_MoveSprite(int16_t xOld, int16_t yOld, int16_t xNew, int16_t yNew,
+                    int16_t width, int16_t height, uint16_t Sprite[], uint16_t Background)
+{
+    Rect from = { xOld, xOld + width - 1, yOld, yOld + height - 1 };
+    Rect to = { xNew, xNew + width - 1, yNew, yNew + height - 1 };
+    Rect exposed[4];
+
+    uint32_t n = RectDifference(&from, &to, exposed);
+    for (uint32_t i = 0; i < n; i++)
+        LCD_Invalidate(exposed[i].xStart, exposed[i].xEnd, exposed[i].yStart, exposed[i].yEnd);
+
+    /* a merged rectangle may reach into the new box, repaint before the sprite is drawn over it */
+    LCD_RepaintDirty(Background);
+    LCD_DrawRectangleWithColor(to.xStart, to.xEnd, to.yStart, to.yEnd, Sprite);
+}
+
+/************************************  Public Functions  *******************************************/
@@ -0,0 +1,83 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/23/2020                                                |
+ * | SUMMARY: LCDDirty.h                                             |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifndef LCDDIRTY_H_
+#define LCDDIRTY_H_
+
+#include <stdint.h>
+#include "LCDLib.h"
+
+/*
+ * Dirty rectangles of the LCD: areas that have to be
+ * repainted with the background are collected first,
+ * merged where one window is cheaper than two, and only
+ * then written. Moving a sprite repaints the strips its
+ * old box leaves uncovered instead of the whole box.
+ * Callers hold LCDMutex, the list is shared
+ */
+
+/************************************ Defines *******************************************/
+
+/* Most rectangles waiting to be repainted, more are merged into the closest one */
+#define LCD_MAX_DIRTY           8
+
+/* A window costs 6 register writes and the GRAM index, 40 bytes or 20 pixels */
+#define LCD_WINDOW_COST_PX      20
+
+/************************************ Defines *******************************************/
+
+/********************************** Structures ******************************************/
+typedef struct Rect {
+    int16_t xStart;
+    int16_t xEnd;
+    int16_t yStart;
+    int16_t yEnd;
+}Rect;
+/********************************** Structures ******************************************/
+
+/************************************ Public Functions  *******************************************/
+
+/*******************************************************************************
+ * Function Name  : LCD_Invalidate
+ * Description    : Marks a rectangle to be repainted with the background
+ * Input          : xStart, xEnd, yStart, yEnd
+ * Output         : None
+ * Return         : None
+ * Attention      : Ends are inclusive, as in LCD_DrawRectangle. The
+ *                  rectangle is merged with any waiting one whose union
+ *                  costs less than a second window
+ *******************************************************************************/
+void LCD_Invalidate(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd);
+
+/*******************************************************************************
+ * Function Name  : LCD_RepaintDirty
+ * Description    : Fills every waiting rectangle with Color and empties the list
+ * Input          : Color
+ * Output         : None
+ * Return         : None
+ * Attention      : None
+ *******************************************************************************/
+void LCD_RepaintDirty(uint16_t Color);
+
+/*******************************************************************************
+ * Function Name  : LCD_MoveSprite
+ * Description    : Moves a sprite drawn at (xOld, yOld) to (xNew, yNew)
+ * Input          : xOld, yOld, xNew, yNew: top left corners
+ *                  width, height, Sprite: pixels as in LCD_DrawRectangleWithColor
+ *                  Background: color behind the sprite
+ * Output         : None
+ * Return         : None
+ * Attention      : Repaints only the part of the old box the new one does
+ *                  not cover, then draws the sprite once
+ *******************************************************************************/
+void LCD_MoveSprite(int16_t xOld, int16_t yOld, int16_t xNew, int16_t yNew,
+                    int16_t width, int16_t height, uint16_t Sprite[], uint16_t Background);
+
+/************************************ Public Functions  *******************************************/
+
+#endif /* LCDDIRTY_H_ */
@@ -9,6 +9,14 @@
 #include "msp.h"
 #include "driverlib.h"
 #include "AsciiLib.h"
+#include "G8RTOS_Boot.h"
+#include "G8RTOS_Metrics.h"
+#include "G8RTOS_Scheduler.h"
+#include "G8RTOS_Semaphores.h"
+
+/* pixels written and the size of every rectangle fill */
+G8RTOS_COUNTER(LCDPixels, "lcd.pixels");
+G8RTOS_HISTOGRAM(LCDFillSize, "lcd.fill_px", 64, 256, 1024, 4096, 16384);
 
 /* spi config */
 const eUSCI_SPI_MasterConfig spiMasterConfig = {
@@ -21,6 +29,24 @@ const eUSCI_SPI_MasterConfig spiMasterConfig = {
         EUSCI_B_SPI_3PIN                                            // 3Wire SPI Mode
         };
 
+/* uDMA control table, the controller needs it aligned to its size */
+#ifdef __TI_COMPILER_VERSION__
+#pragma DATA_ALIGN(DMAControlTable, 1024)
+#endif
+static uint8_t DMAControlTable[1024];
+
+/* Pixels byte swapped for the SPI, MSB first: two blit buffers and a cycle of the last fill color */
+static uint8_t DMABlit[2][LCD_DMA_CYCLE_BYTES];
+static uint8_t DMAPattern[LCD_DMA_CYCLE_BYTES];
+static uint16_t DMAPatternColor;
+static uint8_t DMAFillByte;
+
+/* Transfer in progress, every cycle restarts at DMASource until DMARemaining bytes are sent */
+static const uint8_t *DMASource;
+static volatile uint32_t DMARemaining;
+static semaphore_t DMADone;
+static bool DMAReady;
+
 /************************************  Private Functions  *******************************************/
 
 /*
@@ -88,6 +114,208 @@ static void LCD_initSPI()
     GPIO_setOutputHighOnPin(GPIO_PORT_P10, GPIO_PIN5);
 }
 
+/*******************************************************************************
+ * Function Name  : LCD_DMAStartCycle
+ * Description    : Starts the next cycle of the transfer in progress
+ * Input          : None
+ * Output         : None
+ * Return         : None
+ * Attention      : Called from threads and LCD_DMAHandler
+ *******************************************************************************/
+static void LCD_DMAStartCycle()
+{
+    uint32_t bytes = DMARemaining < LCD_DMA_CYCLE_BYTES ? DMARemaining : LCD_DMA_CYCLE_BYTES;
+    DMARemaining -= bytes;
+
+    DMA_setChannelTransfer(UDMA_PRI_SELECT | LCD_DMA_CHANNEL, UDMA_MODE_BASIC, (void *)DMASource,
+                           (void *)SPI_getTransmitBufferAddressForDMA(EUSCI_B3_BASE), bytes);
+    DMA_enableChannel(LCD_DMA_CHANNEL);
+
+    /* requests come on the rising edge of TXIFG, make one once TXBUF is free */
+    while (!(EUSCI_B3->IFG & EUSCI_B_IFG_TXIFG));
+    EUSCI_B3->IFG &= ~EUSCI_B_IFG_TXIFG;
+    EUSCI_B3->IFG |= EUSCI_B_IFG_TXIFG;
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_DMAHandler
+ * Description    : DMA_INT1 handler, chains the cycles of a transfer
+ * Input          : None
+ * Output         : None
+ * Return         : None
+ * Attention      : Signals DMADone once the last byte is in TXBUF
+ *******************************************************************************/
+static void LCD_DMAHandler()
+{
+    DMA_clearInterruptFlag(LCD_DMA_CHANNEL);
+
+    if (DMARemaining)
+        LCD_DMAStartCycle();
+    else
+        G8RTOS_SignalSemaphore(&DMADone);
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_initDMA
+ * Description    : Configures the uDMA channel that feeds EUSCI_B3 TX
+ * Input          : None
+ * Output         : None
+ * Return         : None
+ * Attention      : One byte moves per TX request, cycles end on DMA_INT1
+ *******************************************************************************/
+static void LCD_initDMA()
+{
+    DMA_enableModule();
+    DMA_setControlBase(DMAControlTable);
+
+    DMA_assignChannel(DMA_CH6_EUSCIB3TX0);
+    DMA_disableChannelAttribute(LCD_DMA_CHANNEL, UDMA_ATTR_ALTSELECT | UDMA_ATTR_USEBURST |
+                                UDMA_ATTR_HIGH_PRIORITY | UDMA_ATTR_REQMASK);
+
+    G8RTOS_InitSemaphore(&DMADone, 0);
+    DMA_assignInterrupt(DMA_INT1, LCD_DMA_CHANNEL);
+    DMA_clearInterruptFlag(LCD_DMA_CHANNEL);
+    G8RTOS_AddAperiodicEvent(LCD_DMAHandler, LCD_DMA_IRQ_PRIORITY, DMA_INT1_IRQn);
+
+    DMAReady = true;
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_UseDMA
+ * Description    : Whether an area of pixels goes through the uDMA
+ * Input          : pixels
+ * Output         : None
+ * Return         : true to use LCD_FillDMA or LCD_BlitDMA
+ * Attention      : The caller blocks on DMADone, so only threads use it,
+ *                  draws before G8RTOS_Launch stay on the CPU
+ *******************************************************************************/
+static bool LCD_UseDMA(int32_t pixels)
+{
+    return DMAReady && pixels >= LCD_DMA_MIN_PIXELS && G8RTOS_IsRunning();
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_WriteDMA
+ * Description    : Sends bytes from source to the LCD and waits for them
+ * Input          : source, bytes, fixedSource
+ * Output         : None
+ * Return         : None
+ * Attention      : The LCD must be in a GRAM write, holding LCDMutex.
+ *                  Transfers longer than a cycle send source again each cycle
+ *******************************************************************************/
+static void LCD_WriteDMA(const uint8_t *source, uint32_t bytes, bool fixedSource)
+{
+    DMA_setChannelControl(UDMA_PRI_SELECT | LCD_DMA_CHANNEL, UDMA_SIZE_8 |
+                          (fixedSource ? UDMA_SRC_INC_NONE : UDMA_SRC_INC_8) | UDMA_DST_INC_NONE | UDMA_ARB_1);
+
+    DMASource = source;
+    DMARemaining = bytes;
+    LCD_DMAStartCycle();
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_WaitDMA
+ * Description    : Blocks until the transfer is on the wire
+ * Input          : None
+ * Output         : None
+ * Return         : None
+ * Attention      : None
+ *******************************************************************************/
+static void LCD_WaitDMA()
+{
+    G8RTOS_WaitSemaphore(&DMADone);
+
+    /* the last byte still has to leave the shift register */
+    while (EUSCI_B_SPI_isBusy(EUSCI_B3_BASE));
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_FillDMA
+ * Description    : Sends pixels of one color through the uDMA
+ * Input          : Color, pixels
+ * Output         : None
+ * Return         : None
+ * Attention      : A color with equal bytes is read from one fixed byte,
+ *                  any other from a cycle long pattern kept between fills
+ *******************************************************************************/
+static void LCD_FillDMA(uint16_t Color, uint32_t pixels)
+{
+    uint8_t high = Color >> 8;
+    uint8_t low = Color & 0xFF;
+
+    if (high == low)
+    {
+        DMAFillByte = high;
+        LCD_WriteDMA(&DMAFillByte, pixels * 2, true);
+    }
+    else
+    {
+        /* the pattern starts out all 0, LCD_BLACK */
+        if (Color != DMAPatternColor)
+        {
+            for (uint32_t i = 0; i < LCD_DMA_CYCLE_BYTES / 2; i++)
+            {
+                DMAPattern[2 * i] = high;
+                DMAPattern[2 * i + 1] = low;
+            }
+            DMAPatternColor = Color;
+        }
+
+        LCD_WriteDMA(DMAPattern, pixels * 2, false);
+    }
+
+    LCD_WaitDMA();
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_SwapPixels
+ * Description    : Copies up to a cycle of pixels MSB first into buffer
+ * Input          : buffer, Color, pixels
+ * Output         : None
+ * Return         : Pixels copied
+ * Attention      : None
+ *******************************************************************************/
+static uint32_t LCD_SwapPixels(uint8_t *buffer, const uint16_t *Color, uint32_t pixels)
+{
+    uint32_t n = pixels < LCD_DMA_CYCLE_BYTES / 2 ? pixels : LCD_DMA_CYCLE_BYTES / 2;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        buffer[2 * i] = Color[i] >> 8;
+        buffer[2 * i + 1] = Color[i] & 0xFF;
+    }
+
+    return n;
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_BlitDMA
+ * Description    : Sends an array of pixels through the uDMA
+ * Input          : Color, pixels
+ * Output         : None
+ * Return         : None
+ * Attention      : The next cycle is swapped into the other buffer while
+ *                  the current one is sent
+ *******************************************************************************/
+static void LCD_BlitDMA(const uint16_t *Color, uint32_t pixels)
+{
+    uint32_t buffer = 0;
+    uint32_t n = LCD_SwapPixels(DMABlit[0], Color, pixels);
+
+    while (n)
+    {
+        LCD_WriteDMA(DMABlit[buffer], n * 2, false);
+        Color += n;
+        pixels -= n;
+
+        buffer ^= 1;
+        uint32_t next = LCD_SwapPixels(DMABlit[buffer], Color, pixels);
+
+        LCD_WaitDMA();
+        n = next;
+    }
+}
+
 /************************************  Private Functions  *******************************************/
 
 
@@ -128,11 +356,21 @@ void LCD_DrawRectangleWithColor(int16_t xStart, int16_t xEnd, int16_t yStart, in
     LCD_WriteIndex(GRAM);
 
     /* Send out data only to the entire area */
+    int32_t pixels = (xEnd - xStart + 1) * (yEnd - yStart + 1);
     SPI_CS_LOW;
     LCD_Write_Data_Start();
-    for (int i = 0; i < (xEnd - xStart + 1) * (yEnd - yStart + 1); i++)
-        LCD_Write_Data_Only(Color[i]);
+    if (LCD_UseDMA(pixels))
+        LCD_BlitDMA(Color, pixels);
+    else
+        for (int i = 0; i < pixels; i++)
+            LCD_Write_Data_Only(Color[i]);
     SPI_CS_HIGH;
+
+    if (pixels > 0)
+    {
+        G8RTOS_MetricAdd(&LCDPixels, pixels);
+        G8RTOS_MetricObserve(&LCDFillSize, pixels);
+    }
 }
 
 /*******************************************************************************
@@ -170,11 +408,21 @@ void LCD_DrawRectangle(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEn
     LCD_WriteIndex(GRAM);
 
     /* Send out data only to the entire area */
+    int32_t pixels = (xEnd - xStart + 1) * (yEnd - yStart + 1);
     SPI_CS_LOW;
     LCD_Write_Data_Start();
-    for (int i = 0; i < (xEnd - xStart + 1) * (yEnd - yStart + 1); i++)
-        LCD_Write_Data_Only(Color);
+    if (LCD_UseDMA(pixels))
+        LCD_FillDMA(Color, pixels);
+    else
+        for (int i = 0; i < pixels; i++)
+            LCD_Write_Data_Only(Color);
     SPI_CS_HIGH;
+
+    if (pixels > 0)
+    {
+        G8RTOS_MetricAdd(&LCDPixels, pixels);
+        G8RTOS_MetricObserve(&LCDFillSize, pixels);
+    }
 }
 
 /******************************************************************************
@@ -274,10 +522,15 @@ void LCD_Clear(uint16_t Color)
     // You'll need to call LCD_Write_Data_Start() and then send out only data to fill entire screen with color
     LCD_Write_Data_Start();
 
-    for (int i = 0; i < SCREEN_SIZE; i++)
-        LCD_Write_Data_Only(Color);
+    if (LCD_UseDMA(SCREEN_SIZE))
+        LCD_FillDMA(Color, SCREEN_SIZE);
+    else
+        for (int i = 0; i < SCREEN_SIZE; i++)
+            LCD_Write_Data_Only(Color);
 
     SPI_CS_HIGH;
+
+    G8RTOS_MetricAdd(&LCDPixels, SCREEN_SIZE);
 }
 
 /******************************************************************************
@@ -480,7 +733,13 @@ inline void LCD_SetCursor(uint16_t Xpos, uint16_t Ypos )
  *******************************************************************************/
 void LCD_Init(bool usingTP)
 {
+    G8RTOS_RegisterMetric(&LCDPixels);
+    G8RTOS_RegisterMetric(&LCDFillSize);
+
+    G8RTOS_BootBegin("LCD_initSPI");
     LCD_initSPI();
+    LCD_initDMA();
+    G8RTOS_BootEnd();
 
     if (usingTP)
     {
@@ -488,17 +747,20 @@ void LCD_Init(bool usingTP)
         //GPIO_setAsInputPinWithPullUpResistor(GPIO_PORT_P4, GPIO_PIN0);
         //GPIO_interruptEdgeSelect(GPIO_PORT_P4, GPIO_PIN0, GPIO_HIGH_TO_LOW_TRANSITION);
 
+        // P4.0 shares the port 4 interrupt with the joystick button, the
+        // touch handler is registered with G8RTOS_AddGPIOEvent(4, 0, GPIO_EDGE_FALLING, ...)
         P4->DIR &= ~BIT0;   // P4.0 direction set as input
-        P4->IFG &= ~BIT0;   // P4.0 IFG cleared
-        P4->IE |= BIT0;     // Enable interrupt on P4.4
-        P4->IES |= BIT0;    // high-to-low transition
         P4->REN |= BIT0;    // Pull-up resister
         P4->OUT |= BIT0;    // Sets res to pull-up
         //GPIO_enableInterrupt(GPIO_PORT_P4, GPIO_PIN0);
     }
 
+    G8RTOS_BootBegin("LCD_reset");
     LCD_reset();
+    G8RTOS_BootEnd();
 
+    /* register writes, mostly the power on delays */
+    G8RTOS_BootBegin("LCD_registers");
     LCD_WriteReg(0xE5, 0x78F0); /* set SRAM internal timing */
     LCD_WriteReg(DRIVER_OUTPUT_CONTROL, 0x0100); /* set Driver Output Control */
     LCD_WriteReg(DRIVING_WAVE_CONTROL, 0x0700); /* set 1 line inversion */
@@ -566,8 +828,11 @@ void LCD_Init(bool usingTP)
     LCD_WriteReg(PANEL_ITERFACE_CONTROL_2, 0x0600);
     LCD_WriteReg(DISPLAY_CONTROL_1, 0x0133); /* 262K color and display ON */
     Delay(50); /* delay 50 ms */
+    G8RTOS_BootEnd();
 
+    G8RTOS_BootBegin("LCD_Clear");
     LCD_Clear(LCD_BLACK);
+    G8RTOS_BootEnd();
 }
 
 /*******************************************************************************
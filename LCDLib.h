@@ -34,6 +34,12 @@
 #define SPI_CS_TP_LOW P10OUT &= ~BIT5
 #define SPI_CS_TP_HIGH P10OUT |= BIT5
 
+/* uDMA channel 6 feeds EUSCI_B3 TX with bulk pixel data */
+#define LCD_DMA_CHANNEL         6
+#define LCD_DMA_CYCLE_BYTES     1024    /* most bytes the uDMA moves in one cycle */
+#define LCD_DMA_MIN_PIXELS      64      /* smaller areas are cheaper to write with the CPU */
+#define LCD_DMA_IRQ_PRIORITY    5
+
 /* XPT2046 registers definition for X and Y coordinate retrieval */
 #define CHX         0x90
 #define CHY         0xD0
@@ -151,7 +157,7 @@ void LCD_DrawRectangleWithColor(int16_t xStart, int16_t xEnd, int16_t yStart, in
 * Return         : None
 * Attention      : None
 *******************************************************************************/
-inline void PutChar( uint16_t Xpos, uint16_t Ypos, uint8_t ASCI, uint16_t charColor);
+void PutChar( uint16_t Xpos, uint16_t Ypos, uint8_t ASCI, uint16_t charColor);
 
 /******************************************************************************
 * Function Name  : LCD_Text
@@ -174,7 +180,7 @@ void LCD_Text(uint16_t Xpos, uint16_t Ypos, uint8_t *str,uint16_t Color);
 * Return         : None
 * Attention      : None
 *******************************************************************************/
-inline void LCD_Write_Data_Only(uint16_t data);
+void LCD_Write_Data_Only(uint16_t data);
 
 /*******************************************************************************
 * Function Name  : LCD_Clear
@@ -205,7 +211,7 @@ void LCD_SetPoint(uint16_t Xpos, uint16_t Ypos, uint16_t color);
 * Return         : None
 * Attention      : None
 *******************************************************************************/
-inline void LCD_WriteData(uint16_t data);
+void LCD_WriteData(uint16_t data);
 
 /*******************************************************************************
 * Function Name  : LCD_WriteReg
@@ -215,7 +221,7 @@ inline void LCD_WriteData(uint16_t data);
 * Return         : LCD Register Value.
 * Attention      : None
 *******************************************************************************/
-inline uint16_t LCD_ReadReg(uint16_t LCD_reg);
+uint16_t LCD_ReadReg(uint16_t LCD_reg);
 
 /*******************************************************************************
 * Function Name  : LCD_WriteIndex
@@ -225,7 +231,7 @@ inline uint16_t LCD_ReadReg(uint16_t LCD_reg);
 * Return         : None
 * Attention      : None
 *******************************************************************************/
-inline void LCD_WriteIndex(uint16_t index);
+void LCD_WriteIndex(uint16_t index);
 
 /*******************************************************************************
  * Function Name  : SPISendRecvTPByte
@@ -235,7 +241,7 @@ inline void LCD_WriteIndex(uint16_t index);
  * Return         : None
  * Attention      : None
  *******************************************************************************/
-inline uint8_t SPISendRecvTPByte (uint8_t byte);
+uint8_t SPISendRecvTPByte (uint8_t byte);
 
 /*******************************************************************************
 * Function Name  : SPISendRecvByte
@@ -245,7 +251,7 @@ inline uint8_t SPISendRecvTPByte (uint8_t byte);
 * Return         : Recieved value 
 * Attention      : None
 *******************************************************************************/
-inline uint8_t SPISendRecvByte(uint8_t byte);
+uint8_t SPISendRecvByte(uint8_t byte);
 
 /*******************************************************************************
 * Function Name  : LCD_Write_Data_Start
@@ -255,7 +261,7 @@ inline uint8_t SPISendRecvByte(uint8_t byte);
 * Return         : None
 * Attention      : None
 *******************************************************************************/
-inline void LCD_Write_Data_Start(void);
+void LCD_Write_Data_Start(void);
 
 /*******************************************************************************
 * Function Name  : LCD_ReadData
@@ -265,7 +271,7 @@ inline void LCD_Write_Data_Start(void);
 * Return         : return data
 * Attention  : None
 *******************************************************************************/
-inline uint16_t LCD_ReadData();
+uint16_t LCD_ReadData();
 
 /*******************************************************************************
 * Function Name  : LCD_WriteReg
@@ -276,7 +282,7 @@ inline uint16_t LCD_ReadData();
 * Return         : None
 * Attention      : None
 *******************************************************************************/
-inline void LCD_WriteReg(uint16_t LCD_Reg, uint16_t LCD_RegValue);
+void LCD_WriteReg(uint16_t LCD_Reg, uint16_t LCD_RegValue);
 
 /*******************************************************************************
 * Function Name  : LCD_SetCursor
@@ -287,7 +293,7 @@ inline void LCD_WriteReg(uint16_t LCD_Reg, uint16_t LCD_RegValue);
 * Return         : None
 * Attention      : None
 *******************************************************************************/
-inline void LCD_SetCursor(uint16_t Xpos, uint16_t Ypos );
+void LCD_SetCursor(uint16_t Xpos, uint16_t Ypos );
 
 /*******************************************************************************
 * Function Name  : LCD_Init
@@ -330,7 +336,7 @@ uint16_t TP_ReadX();
 uint16_t TP_ReadY();
 
 /************************************ Public Functions  *******************************************/
-inline uint16_t LCD_ReadData2();
+uint16_t LCD_ReadData2();
 uint16_t ReadPixelColor(uint16_t x, uint16_t y);
 
 
@@ -0,0 +1,159 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/18/2020                                                |
+ * | SUMMARY: HostBoard.c                                            |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifdef G8RTOS_PORT_POSIX
+
+/*
+ * Simulated board for the host build: registers are
+ * plain memory, the joystick sweeps on its own and the
+ * LCD only counts the pixels it would have drawn
+ */
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <BSP.h>
+#include "BackChannelUart.h"
+#include "msp.h"
+#include "LCDLib.h"
+#include "G8RTOS.h"
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC VARIABLES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* registers used through msp.h */
+DIO_PORT_Interruptable_Type HostP1, HostP2, HostP3, HostP4, HostP5, HostP6;
+WDT_A_Type HostWDT_A;
+volatile uint32_t HostBitBand;
+
+/* pixels the LCD functions would have written */
+uint32_t HostPixelsDrawn;
+
+/* writes to the LP3943 LEDs */
+uint32_t HostLEDWrites;
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PRIVATE FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * CountRectangle
+ * INPUTS: (int16_t) xStart, (int16_t) xEnd,
+ *         (int16_t) yStart, (int16_t) yEnd
+ * OUTPUTS: void
+ * Adds the pixels of a rectangle clipped to the screen,
+ * ends inclusive as in LCDLib.c
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+static void CountRectangle(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd)
+{
+    if (xStart < MIN_SCREEN_X) xStart = MIN_SCREEN_X;
+    if (yStart < MIN_SCREEN_Y) yStart = MIN_SCREEN_Y;
+    if (xEnd > MAX_SCREEN_X) xEnd = MAX_SCREEN_X;
+    if (yEnd > MAX_SCREEN_Y) yEnd = MAX_SCREEN_Y;
+
+    if (xEnd >= xStart && yEnd >= yStart)
+        HostPixelsDrawn += (uint32_t)(xEnd - xStart + 1) * (uint32_t)(yEnd - yStart + 1);
+}
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+void BSP_InitBoard()
+{
+    HostPixelsDrawn = 0;
+}
+
+void BSP_InitThread()
+{
+    G8RTOS_KillSelf();
+}
+
+bool BSP_IsReady(BSP_Peripheral_t peripheral)
+{
+    return true;
+}
+
+void LP3943_LedModeSet(uint32_t unit, uint16_t LED_DATA)
+{
+    HostLEDWrites++;
+}
+
+uint32_t ClockSys_GetSysFreq()
+{
+    return 48000000;
+}
+
+void BackChannelWrite(const char * string)
+{
+    fputs(string, stdout);
+    fflush(stdout);
+}
+
+void GetJoystickCoordinates(int16_t *x_coord, int16_t *y_coord)
+{
+    /* push left and right for a second each, rest in between */
+    uint32_t phase = (SystemTime / 1000) % 4;
+    *x_coord = (phase == 0) ? 4000 : (phase == 2) ? -4000 : 0;
+    *y_coord = 0;
+}
+
+void LCD_Init(bool usingTP)
+{
+    (void)usingTP;
+}
+
+void LCD_Clear(uint16_t Color)
+{
+    (void)Color;
+    HostPixelsDrawn += SCREEN_SIZE;
+}
+
+void LCD_DrawRectangle(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd, uint16_t Color)
+{
+    (void)Color;
+    CountRectangle(xStart, xEnd, yStart, yEnd);
+}
+
+void LCD_DrawRectangleWithColor(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd, uint16_t Color[])
+{
+    (void)Color;
+    CountRectangle(xStart, xEnd, yStart, yEnd);
+}
+
+void LCD_Text(uint16_t Xpos, uint16_t Ypos, uint8_t *str, uint16_t Color)
+{
+    (void)Xpos; (void)Ypos; (void)Color;
+
+    /* 8x16 font */
+    while (*str++)
+        HostPixelsDrawn += 8 * 16;
+}
+
+void LCD_SetPoint(uint16_t Xpos, uint16_t Ypos, uint16_t color)
+{
+    (void)Xpos; (void)Ypos; (void)color;
+    HostPixelsDrawn++;
+}
+
+#endif /* G8RTOS_PORT_POSIX */
@@ -0,0 +1,192 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/18/2020                                                |
+ * | SUMMARY: HostNetwork.c                                          |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifdef G8RTOS_PORT_POSIX
+
+/*
+ * Simulated CC3100 for the host build. The other player
+ * lives in this file: it answers the join handshake and
+ * then sends one packet every PEER_PERIOD_MS
+ *  - As the client it sends displacements that sweep
+ *    left and right
+ *  - As the host it sends the game state, moving the
+ *    client by the displacements it received
+ */
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "Game.h"
+#include "cc3100_usage.h"
+#include "G8RTOS_Metrics.h"
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                        DEFINES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* ms between two packets of the simulated peer */
+#define PEER_PERIOD_MS 5
+
+/* addresses of this player and the simulated peer */
+#define LOCAL_IP 0xC0A80079
+#define PEER_IP 0xC0A8007A
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PRIVATE VARIABLES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* role of this player */
+static playerType LocalRole;
+
+/* game state kept by the peer */
+static GameState_t PeerState;
+
+/* SystemTime of the peer's last packet */
+static uint32_t LastPeerPacket;
+
+/* packets sent and received by this player, the same metrics as the CC3100 code, sends never fail */
+G8RTOS_COUNTER(PacketsSent, "net.tx");
+G8RTOS_COUNTER(PacketsReceived, "net.rx");
+G8RTOS_COUNTER(SendErrors, "net.tx_errors");
+
+/* telemetry records that would have gone to the collector */
+G8RTOS_COUNTER(TelemetrySent, "net.telemetry");
+G8RTOS_COUNTER(TelemetryErrors, "net.telemetry_errors");
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * initCC3100
+ * INPUTS: (playerType) playerRole
+ * OUTPUTS: void
+ * Makes the simulated peer play the other role
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void initCC3100(playerType playerRole)
+{
+    LocalRole = playerRole;
+    LastPeerPacket = SystemTime;
+    G8RTOS_RegisterMetric(&PacketsSent);
+    G8RTOS_RegisterMetric(&PacketsReceived);
+    G8RTOS_RegisterMetric(&SendErrors);
+    G8RTOS_RegisterMetric(&TelemetrySent);
+    G8RTOS_RegisterMetric(&TelemetryErrors);
+
+    /* the peer starts where CreateGame puts the players */
+    memset(&PeerState, 0, sizeof(PeerState));
+    PeerState.player.IP_address = PEER_IP;
+    PeerState.player.joined = true;
+    PeerState.player.acknowledge = true;
+    PeerState.players[0].currentCenterX = 294;
+    PeerState.players[0].currentCenterY = 220;
+    PeerState.players[0].color = player1;
+    PeerState.players[1].currentCenterX = 26;
+    PeerState.players[1].currentCenterY = 220;
+    PeerState.players[1].color = player2;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * getLocalIP
+ * INPUTS: void
+ * OUTPUTS: (uint32_t) IP
+ * Returns a fixed address for this player
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t getLocalIP()
+{
+    return LOCAL_IP;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * SendData
+ * INPUTS: (uint8_t *) data, (uint32_t) IP,
+ *         (uint16_t) BUF_SIZE
+ * OUTPUTS: void
+ * Counts the packet, a host peer also applies the
+ * client's displacement to its game state
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void SendData(uint8_t *data, uint32_t IP, uint16_t BUF_SIZE)
+{
+    (void)IP;
+    G8RTOS_MetricAdd(&PacketsSent, 1);
+
+    /* only the client's packets change the peer */
+    if (LocalRole != Client || BUF_SIZE < sizeof(GameState_t))
+        return;
+
+    GameState_t packet;
+    memcpy(&packet, data, sizeof(packet));
+
+    PeerState.players[1].currentCenterX += packet.player.displacementX;
+    if ((PeerState.players[1].currentCenterX < 8) || (PeerState.players[1].currentCenterX > 313))
+        PeerState.players[1].currentCenterX -= packet.player.displacementX;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * ReceiveData
+ * INPUTS: (uint8_t *) data, (uint16_t) BUF_SIZE
+ * OUTPUTS: (int32_t) bytes received
+ * Returns the simulated peer's next packet, or
+ * NOTHING_RECEIVED until the peer sends one
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int32_t ReceiveData(uint8_t *data, uint16_t BUF_SIZE)
+{
+    /* the peer sends one packet every period */
+    if (SystemTime - LastPeerPacket < PEER_PERIOD_MS)
+        return NOTHING_RECEIVED;
+    LastPeerPacket = SystemTime;
+
+    /* a client peer sweeps across the arena */
+    if (LocalRole == Host)
+        PeerState.player.displacementX = ((SystemTime / 2000) & 1) ? 4 : -4;
+
+    uint16_t size = BUF_SIZE < sizeof(PeerState) ? BUF_SIZE : sizeof(PeerState);
+    memcpy(data, &PeerState, size);
+    G8RTOS_MetricAdd(&PacketsReceived, 1);
+
+    return size;
+}
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * SendTelemetry
+ * INPUTS: (uint8_t *) data, (uint16_t) BUF_SIZE
+ * OUTPUTS: (int32_t) error
+ * Counts the record, the back channel copy on stdout is
+ * the host's collector
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int32_t SendTelemetry(uint8_t *data, uint16_t BUF_SIZE)
+{
+    (void)data;
+    (void)BUF_SIZE;
+    G8RTOS_MetricAdd(&TelemetrySent, 1);
+
+    return 0;
+}
+
+#endif /* G8RTOS_PORT_POSIX */
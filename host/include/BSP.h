@@ -0,0 +1,125 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/18/2020                                                |
+ * | SUMMARY: BSP.h (host)                                           |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifndef HOST_BSP_H_
+#define HOST_BSP_H_
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Stands in for the board support package on the host,
+ * implemented by host/HostBoard.c
+ */
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                        DEFINES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* priority of BSP_InitThread, below the game threads */
+#define BSP_INIT_THREAD_PRIORITY 200
+
+/* peripherals of the board, see BoardSupportPackage/inc/BSP.h */
+typedef enum
+{
+    BSP_JOYSTICK,
+    BSP_BACKCHANNEL,
+    BSP_RGBLEDS,
+    BSP_I2C,
+    BSP_OPT3001,
+    BSP_TMP007,
+    BSP_BMI160,
+    BSP_BME280,
+    BSP_NUM_PERIPHERALS
+} BSP_Peripheral_t;
+
+/* LP3943 units, see BoardSupportPackage/inc/RGBLeds.h */
+typedef enum device
+{
+    BLUE = 0,
+    GREEN = 1,
+    RED = 2
+} unit_desig;
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * BSP_InitBoard
+ * INPUTS: void
+ * OUTPUTS: void
+ * Resets the simulated joystick and LCD counters
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void BSP_InitBoard();
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * BSP_InitThread
+ * INPUTS: void
+ * OUTPUTS: void
+ * Thread that brings up the background peripherals on
+ * the board, the host has none so it kills itself
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void BSP_InitThread();
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * BSP_IsReady
+ * INPUTS: (BSP_Peripheral_t) peripheral
+ * OUTPUTS: (bool) ready
+ * The host peripherals are always ready
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+bool BSP_IsReady(BSP_Peripheral_t peripheral);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * LP3943_LedModeSet
+ * INPUTS: (uint32_t) unit, (uint16_t) LED_DATA
+ * OUTPUTS: void
+ * Counts LED writes in HostLEDWrites
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void LP3943_LedModeSet(uint32_t unit, uint16_t LED_DATA);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * ClockSys_GetSysFreq
+ * INPUTS: void
+ * OUTPUTS: (uint32_t) frequency
+ * Returns the board's 48 MHz system clock
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t ClockSys_GetSysFreq();
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * GetJoystickCoordinates
+ * INPUTS: (int16_t *) x_coord, (int16_t *) y_coord
+ * OUTPUTS: void
+ * Reads the simulated joystick, which sweeps left and
+ * right every few seconds of SystemTime
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void GetJoystickCoordinates(int16_t *x_coord, int16_t *y_coord);
+
+#endif /* HOST_BSP_H_ */
@@ -0,0 +1,33 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/19/2020                                                |
+ * | SUMMARY: BackChannelUart.h (host)                               |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifndef HOST_BACKCHANNELUART_H_
+#define HOST_BACKCHANNELUART_H_
+
+/*
+ * The back channel UART is stdout on the host,
+ * implemented by host/HostBoard.c
+ */
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * BackChannelWrite
+ * INPUTS: (const char *) string
+ * OUTPUTS: void
+ * Writes string to stdout as is
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void BackChannelWrite(const char * string);
+
+#endif /* HOST_BACKCHANNELUART_H_ */
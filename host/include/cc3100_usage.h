@@ -0,0 +1,108 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/18/2020                                                |
+ * | SUMMARY: cc3100_usage.h (host)                                  |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifndef HOST_CC3100_USAGE_H_
+#define HOST_CC3100_USAGE_H_
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+
+/*
+ * Stands in for the CC3100 driver on the host. There is
+ * no radio, host/HostNetwork.c plays the other player
+ */
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                        DEFINES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* address the client sends to */
+#define HOST_IP_ADDR 0xC0A80078
+
+/* ReceiveData return value when no packet is waiting */
+#define NOTHING_RECEIVED -1
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                  DATA TYPE DEFINITIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* whether the player is the host or client */
+typedef enum
+{
+    Client = 0,
+    Host = 1
+} playerType;
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * SendData
+ * INPUTS: (uint8_t *) data, (uint32_t) IP,
+ *         (uint16_t) BUF_SIZE
+ * OUTPUTS: void
+ * Counts the packet, nothing leaves the process
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void SendData(uint8_t *data, uint32_t IP, uint16_t BUF_SIZE);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * ReceiveData
+ * INPUTS: (uint8_t *) data, (uint16_t) BUF_SIZE
+ * OUTPUTS: (int32_t) bytes received
+ * Returns the simulated peer's next packet, or
+ * NOTHING_RECEIVED until the peer sends one
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int32_t ReceiveData(uint8_t *data, uint16_t BUF_SIZE);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * SendTelemetry
+ * INPUTS: (uint8_t *) data, (uint16_t) BUF_SIZE
+ * OUTPUTS: (int32_t) error
+ * Counts the record, nothing leaves the process
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+int32_t SendTelemetry(uint8_t *data, uint16_t BUF_SIZE);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * initCC3100
+ * INPUTS: (playerType) playerRole
+ * OUTPUTS: void
+ * Makes the simulated peer play the other role
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+void initCC3100(playerType playerRole);
+
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * getLocalIP
+ * INPUTS: void
+ * OUTPUTS: (uint32_t) IP
+ * Returns a fixed address for this player
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+uint32_t getLocalIP();
+
+#endif /* HOST_CC3100_USAGE_H_ */
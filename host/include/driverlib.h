@@ -0,0 +1,19 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/18/2020                                                |
+ * | SUMMARY: driverlib.h (host)                                     |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifndef HOST_DRIVERLIB_H_
+#define HOST_DRIVERLIB_H_
+
+/*
+ * Stands in for MSP432 DriverLib on the host, nothing
+ * built for the host calls into it
+ */
+
+#include "msp.h"
+
+#endif /* HOST_DRIVERLIB_H_ */
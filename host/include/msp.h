@@ -0,0 +1,155 @@
+/*
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ * | AUTHOR: Camilo Chen                                             |
+ * | DATE: 03/18/2020                                                |
+ * | SUMMARY: msp.h (host)                                           |
+ * +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+ */
+
+#ifndef HOST_MSP_H_
+#define HOST_MSP_H_
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                DEPENDENCIES AND EXTERNS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Stands in for the MSP432 device header on the host.
+ * Only the parts G8RTOS, Game.c and main.c use are
+ * provided, registers are plain memory
+ */
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                  DATA TYPE DEFINITIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* interrupt numbers, same values as the device header */
+typedef enum {
+    PendSV_IRQn = -2,
+    SysTick_IRQn = -1,
+    PSS_IRQn = 0,
+    CS_IRQn = 1,
+    PCM_IRQn = 2,
+    WDT_A_IRQn = 3,
+    FPU_IRQn = 4,
+    FLCTL_IRQn = 5,
+    COMP_E0_IRQn = 6,
+    COMP_E1_IRQn = 7,
+    TA0_0_IRQn = 8,
+    TA0_N_IRQn = 9,
+    TA1_0_IRQn = 10,
+    TA1_N_IRQn = 11,
+    TA2_0_IRQn = 12,
+    TA2_N_IRQn = 13,
+    TA3_0_IRQn = 14,
+    TA3_N_IRQn = 15,
+    EUSCIA0_IRQn = 16,
+    EUSCIA1_IRQn = 17,
+    EUSCIA2_IRQn = 18,
+    EUSCIA3_IRQn = 19,
+    EUSCIB0_IRQn = 20,
+    EUSCIB1_IRQn = 21,
+    EUSCIB2_IRQn = 22,
+    EUSCIB3_IRQn = 23,
+    ADC14_IRQn = 24,
+    T32_INT1_IRQn = 25,
+    T32_INT2_IRQn = 26,
+    T32_INTC_IRQn = 27,
+    AES256_IRQn = 28,
+    RTC_C_IRQn = 29,
+    DMA_ERR_IRQn = 30,
+    DMA_INT3_IRQn = 31,
+    DMA_INT2_IRQn = 32,
+    DMA_INT1_IRQn = 33,
+    DMA_INT0_IRQn = 34,
+    PORT1_IRQn = 35,
+    PORT2_IRQn = 36,
+    PORT3_IRQn = 37,
+    PORT4_IRQn = 38,
+    PORT5_IRQn = 39,
+    PORT6_IRQn = 40
+} IRQn_Type;
+
+/* digital I/O port */
+typedef struct {
+    volatile uint8_t IN;
+    volatile uint8_t OUT;
+    volatile uint8_t DIR;
+    volatile uint8_t REN;
+    volatile uint8_t SEL0;
+    volatile uint8_t SEL1;
+    volatile uint8_t IES;
+    volatile uint8_t IE;
+    volatile uint8_t IFG;
+    volatile uint16_t IV;
+} DIO_PORT_Interruptable_Type;
+
+/* watchdog */
+typedef struct {
+    volatile uint16_t CTL;
+} WDT_A_Type;
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                        DEFINES
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+extern DIO_PORT_Interruptable_Type HostP1, HostP2, HostP3, HostP4, HostP5, HostP6;
+extern WDT_A_Type HostWDT_A;
+
+#define P1 (&HostP1)
+#define P2 (&HostP2)
+#define P3 (&HostP3)
+#define P4 (&HostP4)
+#define P5 (&HostP5)
+#define P6 (&HostP6)
+#define WDT_A (&HostWDT_A)
+
+#define WDT_A_CTL_PW 0x5A00
+#define WDT_A_CTL_HOLD 0x0080
+
+#define BIT0 0x01
+#define BIT1 0x02
+#define BIT2 0x04
+#define BIT3 0x08
+#define BIT4 0x10
+#define BIT5 0x20
+#define BIT6 0x40
+#define BIT7 0x80
+
+/* no bit-band region on the host, bit accesses go to a scratch word */
+extern volatile uint32_t HostBitBand;
+#define BITBAND_PERI(x, b) (HostBitBand)
+
+/* barriers, the host port switches contexts in one process */
+#define __DMB() __sync_synchronize()
+#define __DSB() __sync_synchronize()
+#define __ISB() __sync_synchronize()
+
+/* count leading zeros, 32 for 0 like the CLZ instruction */
+#define __CLZ(x) ((x) ? (uint32_t)__builtin_clz(x) : 32u)
+
+/*
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ *                    PUBLIC FUNCTIONS
+ * +=====+=====+=====+=====+=====+=====+=====+=====+=====+
+ */
+
+/* reverses the bits of x like the RBIT instruction */
+static inline uint32_t __RBIT(uint32_t x)
+{
+    x = ((x >> 1) & 0x55555555) | ((x & 0x55555555) << 1);
+    x = ((x >> 2) & 0x33333333) | ((x & 0x33333333) << 2);
+    x = ((x >> 4) & 0x0F0F0F0F) | ((x & 0x0F0F0F0F) << 4);
+    return __builtin_bswap32(x);
+}
+
+#endif /* HOST_MSP_H_ */
@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+# +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+# | AUTHOR: Camilo Chen                                             |
+# | DATE: 03/20/2020                                                |
+# | SUMMARY: symbolize_profile.py                                   |
+# +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+#
+# Turns the samples written by G8RTOS_DumpProfile into a report of
+# where the CPU time went, per function and per thread.
+#
+#   board: capture the back channel UART (115200 8N1) to a file, then
+#     symbolize_profile.py capture.txt --map Debug/Yerpers.map
+#     symbolize_profile.py capture.txt --elf Debug/Yerpers.out --nm armnm
+#   host:
+#     make profile RUN_MS=5000
+#
+# Lines that are not part of a dump are skipped, so the capture may
+# hold other UART output. Every dump in the file is added up.
+#
+# Samples outside the program's code (libc or the vdso on the host)
+# are reported as [external], samples in a gap between functions as
+# [unknown].
+
+import argparse
+import bisect
+import collections
+import re
+import subprocess
+import sys
+
+# ELF e_machine of 32 bit ARM, whose function symbols carry the Thumb bit
+EM_ARM = 40
+
+
+def read_samples(stream):
+    """Returns (samples, threads, anchors) from one or more dumps"""
+    samples = []
+    threads = {}
+    anchors = {}
+    for line in stream:
+        line = line.strip()
+        if line.startswith("S,"):
+            _, pc, thread = line.split(",", 2)
+            samples.append((int(pc, 16), int(thread)))
+        elif line.startswith("T,"):
+            _, thread, name = line.split(",", 2)
+            threads[int(thread)] = name
+        elif line.startswith("# anchor,"):
+            _, name, address = line.split(",", 2)
+            anchors[name] = int(address, 16)
+    return samples, threads, anchors
+
+
+def elf_is_arm(path):
+    with open(path, "rb") as elf:
+        header = elf.read(20)
+    little = header[5] == 1
+    return int.from_bytes(header[18:20], "little" if little else "big") == EM_ARM
+
+
+def bound_symbols(symbols, end):
+    """Returns sorted (address, end, name) from (address, size, name)
+
+    A symbol without a size ends at the next one or at end, the end of
+    the code. Symbols starting past the code are dropped."""
+    symbols = sorted(symbols)
+    bounded = []
+    for i, (address, size, name) in enumerate(symbols):
+        if address >= end:
+            continue
+        if size:
+            bounded.append((address, address + size, name))
+        else:
+            following = symbols[i + 1][0] if i + 1 < len(symbols) else end
+            bounded.append((address, min(following, end), name))
+    return bounded
+
+
+def symbols_from_elf(path, nm):
+    """Returns sorted (address, end, name) of the functions in the ELF"""
+    thumb = elf_is_arm(path)
+    # GNU nm also lists the PLT stubs as name@plt, other nm do not know --synthetic
+    try:
+        output = subprocess.run([nm, "--defined-only", "-S", "--synthetic", path], check=True,
+                                stdout=subprocess.PIPE, stderr=subprocess.DEVNULL,
+                                universal_newlines=True).stdout
+    except subprocess.CalledProcessError:
+        output = subprocess.run([nm, "--defined-only", "-S", path], check=True,
+                                stdout=subprocess.PIPE, universal_newlines=True).stdout
+    symbols = []
+    for line in output.splitlines():
+        fields = line.split()
+        # address [size] type name, nm leaves out sizes it does not know
+        if len(fields) == 3:
+            fields.insert(1, "0")
+        if len(fields) != 4 or fields[2] not in "TtWw":
+            continue
+        address = int(fields[0], 16)
+        if thumb:
+            address &= ~1
+        symbols.append((address, int(fields[1], 16), fields[3]))
+
+    # the code ends with the last function of known size
+    ends = [address + size for address, size, _ in symbols if size]
+    return bound_symbols(symbols, max(ends) if ends else float("inf"))
+
+
+def symbols_from_map(path):
+    """Returns sorted (address, end, name) from the address sorted symbol
+    table of a TI linker map, bounded by its .text section"""
+    symbols = []
+    text = None
+    in_table = False
+    section = re.compile(r"^\.text\s+\d+\s+([0-9a-fA-F]{8})\s+([0-9a-fA-F]{8})")
+    entry = re.compile(r"^([0-9a-fA-F]{8})\s+(\S+)\s*$")
+    with open(path) as map_file:
+        for line in map_file:
+            match = section.match(line)
+            if match and text is None:
+                text = (int(match.group(1), 16), int(match.group(2), 16))
+                continue
+            if "SORTED BY Symbol Address" in line:
+                in_table = True
+                continue
+            if in_table:
+                match = entry.match(line)
+                if match:
+                    symbols.append((int(match.group(1), 16) & ~1, 0, match.group(2)))
+                elif line.startswith("[") or "GLOBAL SYMBOLS" in line:
+                    break
+
+    # the table has no sizes and lists data too, keep what is in .text
+    if text is None:
+        return bound_symbols(symbols, float("inf"))
+    start, length = text
+    return bound_symbols([symbol for symbol in symbols if symbol[0] >= start], start + length)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Symbolizes G8RTOS_DumpProfile samples")
+    parser.add_argument("dump", nargs="?", type=argparse.FileType("r"), default=sys.stdin,
+                        help="captured UART output, stdin by default")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--elf", help="linked program, read with nm")
+    source.add_argument("--map", help="TI linker map file")
+    parser.add_argument("--nm", default="nm", help="nm of the toolchain (default: nm)")
+    parser.add_argument("--top", type=int, default=20, help="functions listed (default: 20)")
+    args = parser.parse_args()
+
+    samples, threads, anchors = read_samples(args.dump)
+    if not samples:
+        sys.exit("no samples found")
+
+    symbols = symbols_from_elf(args.elf, args.nm) if args.elf else symbols_from_map(args.map)
+    addresses = [address for address, _, _ in symbols]
+    names = {name: address for address, _, name in symbols}
+
+    # position independent host builds load somewhere else than linked
+    slide = 0
+    for name, address in anchors.items():
+        if name in names:
+            slide = (address & ~1) - names[name]
+
+    code_end = max(end for _, end, _ in symbols) if symbols else 0
+
+    def function(pc):
+        address = pc - slide
+        i = bisect.bisect_right(addresses, address) - 1
+        if i < 0 or address >= code_end:
+            return "[external]"
+        _, end, name = symbols[i]
+        return name if address < end else "[unknown]"
+
+    by_function = collections.Counter()
+    by_thread = collections.defaultdict(collections.Counter)
+    for pc, thread in samples:
+        name = function(pc)
+        by_function[name] += 1
+        by_thread[thread][name] += 1
+
+    total = len(samples)
+    print("%d samples" % total)
+    print()
+    print("%8s %7s  %s" % ("samples", "percent", "function"))
+    for name, count in by_function.most_common(args.top):
+        print("%8d %6.1f%%  %s" % (count, 100.0 * count / total, name))
+
+    for thread, counter in sorted(by_thread.items(), key=lambda item: -sum(item[1].values())):
+        count = sum(counter.values())
+        print()
+        print("thread %d %s: %d samples (%.1f%%)" % (thread, threads.get(thread, "?"), count,
+                                                    100.0 * count / total))
+        for name, hits in counter.most_common(5):
+            print("%8d %6.1f%%  %s" % (hits, 100.0 * hits / count, name))
+
+
+if __name__ == "__main__":
+    main()
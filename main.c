@@ -12,12 +12,35 @@ void main(void)
 {
 	WDT_A->CTL = WDT_A_CTL_PW | WDT_A_CTL_HOLD;		// stop watchdog timer
 
+	// c_init, begun in Reset_Handler
+	G8RTOS_BootEnd();
+
+	G8RTOS_BootBegin("G8RTOS_Init");
 	G8RTOS_Init();
+	G8RTOS_BootEnd();
 
+#if G8RTOS_USE_BENCH
+	// kernel benchmarks instead of the game
+	G8RTOS_AddThread(&G8RTOS_Benchmark, BENCH_PRIORITY, "Benchmark");
+#else
 	// client
 	if(PLAYER == 1) G8RTOS_AddThread(&JoinGame, 1, "JoinGame");
 	else G8RTOS_AddThread(&CreateGame, 1, "CreateGame");
 
+	// sensors and LEDs come up behind the game
+	G8RTOS_AddThread(&BSP_InitThread, BSP_INIT_THREAD_PRIORITY, "BSPInit");
+#endif
+
+#if G8RTOS_USE_PROFILER
+	// sample and dump the game
+	G8RTOS_AddThread(&G8RTOS_ProfilerThread, PROFILER_THREAD_PRIORITY, "Profiler");
+#endif
+
+	G8RTOS_BootBegin("LCD_Init");
 	LCD_Init(false);
+	G8RTOS_BootEnd();
+
+	// ended by the game thread once the board is drawn
+	G8RTOS_BootBegin("game_start");
 	G8RTOS_Launch();
 }
@@ -35,6 +35,7 @@
 *****************************************************************************/
 
 #include <stdint.h>
+#include "G8RTOS_Boot.h"
 
 /* Linker variable that marks the top of the stack. */
 extern unsigned long __STACK_END;
@@ -180,7 +181,15 @@ void (* const interruptVectors[])(void) =
 /* application.                                                                */
 void Reset_Handler(void)
 {
+    /* time 0 of the boot profile */
+    G8RTOS_BootStart();
+
+    G8RTOS_BootBegin("SystemInit");
     SystemInit();
+    G8RTOS_BootEnd();
+
+    /* ended in main */
+    G8RTOS_BootBegin("c_init");
 
     /* Jump to the CCS C Initialization Routine. */
     __asm("    .global _c_int00\n"